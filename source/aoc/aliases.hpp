@@ -1,6 +1,9 @@
 #pragma once
 
+#include "util/thread_pool.hpp"
+
 #include <cstdint>
+#include <memory_resource>
 #include <span>
 #include <string_view>
 #include <variant>
@@ -27,6 +30,13 @@ namespace aoc::aliases
 
     using Lines = std::span<const std::string_view>;
 
+    // how an input can be cut down to a smaller one that is still valid, see concepts::Sweepable
+    enum class InputShape
+    {
+        Lines,    // a prefix of the lines of its last section, the sections before it are kept whole
+        Grid,     // a top-left sub-rectangle
+    };
+
     // I don't know where to place this tbh, but since `aoc::concepts::Day` require this to be defined
     // beforehand, may as well place it here alongside `Lines` which is also required to be defined beforehand
     struct Context
@@ -34,8 +44,27 @@ namespace aoc::aliases
         bool m_debug;
         bool m_benchmark;
 
+        // workers a solve may spread its work on, shared with every other solve running at the same time
+        util::ThreadPool* m_pool = nullptr;
+
+        // per-run arena, released after the run (or after every benchmark iteration) so anything allocated from
+        // it must not outlive the call it's passed to; not thread-safe, only use it on the calling thread
+        std::pmr::memory_resource* m_memory = std::pmr::get_default_resource();
+
         bool is_debug() const noexcept { return m_debug; }
         bool is_benchmark() const noexcept { return m_benchmark; }
+
+        // the calling thread included
+        std::size_t threads() const noexcept { return m_pool != nullptr ? m_pool->size() + 1 : 1; }
+
+        std::pmr::memory_resource* memory() const noexcept { return m_memory; }
+
+        // see util::parallel_for, runs `fn(0, count)` right away if there is no pool
+        template <std::invocable<std::size_t, std::size_t> Fn>
+        void parallel_for(std::size_t count, Fn&& fn) const
+        {
+            util::parallel_for(m_pool, count, std::forward<Fn>(fn));
+        }
     };
 
     // like std::identity but instead of returning the arguments, unchanging, this function consumes the
@@ -0,0 +1,81 @@
+// replacement of the global allocation functions, only compiled in with -DAOC_TRACK_ALLOCATIONS=ON
+
+#include "util/alloc_tracker.hpp"
+
+#include <malloc.h>
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    auto& counters = aoc::util::detail::alloc_counters;
+
+    void* allocate(std::size_t size, std::size_t align)
+    {
+        // the allocation functions must return a unique non-null pointer even for 0 byte
+        size = size == 0 ? 1 : size;
+
+        while (true) {
+            auto* ptr = align <= __STDCPP_DEFAULT_NEW_ALIGNMENT__
+                          ? std::malloc(size)
+                          : std::aligned_alloc(align, (size + align - 1) / align * align);
+
+            if (ptr != nullptr) {
+                counters.on_alloc(size, ::malloc_usable_size(ptr));
+                return ptr;
+            }
+
+            if (auto handler = std::get_new_handler(); handler != nullptr) {
+                handler();
+            } else {
+                throw std::bad_alloc{};
+            }
+        }
+    }
+
+    void* allocate_nothrow(std::size_t size, std::size_t align) noexcept
+    {
+        try {
+            return allocate(size, align);
+        } catch (...) {
+            return nullptr;
+        }
+    }
+
+    void deallocate(void* ptr) noexcept
+    {
+        if (ptr != nullptr) {
+            counters.on_free(::malloc_usable_size(ptr));
+            std::free(ptr);
+        }
+    }
+
+    constexpr auto default_align = std::size_t{ __STDCPP_DEFAULT_NEW_ALIGNMENT__ };
+}
+
+// clang-format off
+void* operator new  (std::size_t size)                         { return allocate(size, default_align); }
+void* operator new[](std::size_t size)                         { return allocate(size, default_align); }
+void* operator new  (std::size_t size, std::align_val_t align) { return allocate(size, static_cast<std::size_t>(align)); }
+void* operator new[](std::size_t size, std::align_val_t align) { return allocate(size, static_cast<std::size_t>(align)); }
+
+void* operator new  (std::size_t size, const std::nothrow_t&) noexcept { return allocate_nothrow(size, default_align); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocate_nothrow(size, default_align); }
+
+void* operator new  (std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept { return allocate_nothrow(size, static_cast<std::size_t>(align)); }
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept { return allocate_nothrow(size, static_cast<std::size_t>(align)); }
+
+void operator delete  (void* ptr) noexcept                                     { deallocate(ptr); }
+void operator delete[](void* ptr) noexcept                                     { deallocate(ptr); }
+void operator delete  (void* ptr, std::size_t) noexcept                        { deallocate(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept                        { deallocate(ptr); }
+void operator delete  (void* ptr, std::align_val_t) noexcept                   { deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept                   { deallocate(ptr); }
+void operator delete  (void* ptr, std::size_t, std::align_val_t) noexcept      { deallocate(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept      { deallocate(ptr); }
+void operator delete  (void* ptr, const std::nothrow_t&) noexcept              { deallocate(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept              { deallocate(ptr); }
+void operator delete  (void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { deallocate(ptr); }
+// clang-format on
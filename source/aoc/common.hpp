@@ -3,12 +3,36 @@
 #include "aliases.hpp"
 #include "concepts.hpp"
 #include "meta.hpp"
+#include "util/alloc_tracker.hpp"
+#include "util/arena.hpp"
+#include "util/cold.hpp"
+#include "util/line_index.hpp"
+#include "util/line_reader.hpp"
+#include "util/mapped_file.hpp"
+#include "util/perf_counters.hpp"
+#include "util/profiler.hpp"
+#include "util/result_cache.hpp"
+#include "util/snapshot.hpp"
+#include "util/stats.hpp"
+#include "util/thread_pool.hpp"
+#include "util/trace.hpp"
+#include "util/tsc.hpp"
 
 #include <fmt/base.h>
 #include <fmt/ranges.h>
 #include <fmt/std.h>
 #include <libassert/assert.hpp>
 
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <exception>
+#include <expected>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+
 namespace aoc::common
 {
     namespace fs = std::filesystem;
@@ -16,12 +40,21 @@ namespace aoc::common
     namespace sv = std::views;
 
     using aliases::Context;
+    using aliases::InputShape;
     using aliases::Lines;
 
     using concepts::AreDays;
+    using concepts::BorrowingPartOne;
+    using concepts::BorrowingPartTwo;
     using concepts::Day;
     using concepts::Displayable;
+    using concepts::LineSink;
+    using concepts::Snapshotable;
+    using concepts::SolveBoth;
     using concepts::Streamable;
+    using concepts::StreamingPartOne;
+    using concepts::StreamingPartTwo;
+    using concepts::Sweepable;
 
     enum class Part
     {
@@ -29,74 +62,468 @@ namespace aoc::common
         Two = 0b10,
     };
 
+    template <Part P>
+    using PartTag = std::integral_constant<Part, P>;
+
+    // wall time, read from the clock unless another source is asked for. a timer given a source explicitly also
+    // takes the cost of reading it off every elapsed(), so that a sample of a few ns isn't mostly the timer itself
     struct Timer
     {
-        using Clock     = std::chrono::high_resolution_clock;
-        using TimePoint = Clock::time_point;
-        using Duration  = Clock::duration;
+        using Clock    = std::chrono::high_resolution_clock;
+        using Duration = std::chrono::nanoseconds;
+
+        static_assert(std::is_same_v<Clock::duration, Duration>);
 
         Timer() noexcept
-            : m_start{ Clock::now() }
+            : m_source{ util::ClockSource::Chrono }
+            , m_overhead{}
+            , m_start{ now() }
+        {
+        }
+
+        // falls back to the clock if the tsc is not usable
+        explicit Timer(util::ClockSource source) noexcept
+            : m_source{ source }
+            , m_overhead{}
+            , m_start{}
+        {
+            if (m_source == util::ClockSource::Tsc and not util::tsc_usable()) {
+                m_source = util::ClockSource::Chrono;
+            }
+            m_overhead = overhead(m_source);
+            m_start    = now();
+        }
+
+        Duration elapsed() const noexcept
+        {
+            auto ticks = now() - m_start;
+            auto time  = Duration{ static_cast<Duration::rep>(ticks) };    // negative if the clock was set back
+            if (m_source == util::ClockSource::Tsc) {
+                time = util::tsc_to_ns(ticks);
+            }
+            return std::max(time - m_overhead, Duration{});
+        }
+
+        void reset() noexcept { m_start = now(); }
+
+        std::uint64_t now() const noexcept
+        {
+            if (m_source == util::ClockSource::Tsc) {
+                return util::read_tsc();
+            }
+            return static_cast<std::uint64_t>(Clock::now().time_since_epoch().count());
+        }
+
+        // of a reset() immediately followed by an elapsed(), at best; measured once per source
+        static Duration overhead(util::ClockSource source) noexcept
+        {
+            auto measure = [](util::ClockSource source) {
+                auto timer     = Timer{};
+                timer.m_source = source;
+
+                auto best = Duration::max();
+                for (auto i = 0; i < 1000; ++i) {
+                    timer.reset();
+                    best = std::min(best, timer.elapsed());
+                }
+                return best;
+            };
+
+            if (source == util::ClockSource::Tsc) {
+                static const auto tsc = measure(source);
+                return tsc;
+            }
+            static const auto chrono = measure(source);
+            return chrono;
+        }
+
+        util::ClockSource m_source;
+        Duration          m_overhead;
+        std::uint64_t     m_start;    // in ticks of the source
+    };
+
+    // cpu time consumed by the calling thread, unlike Timer it doesn't advance while the thread is not running
+    struct CpuTimer
+    {
+        using Duration = std::chrono::nanoseconds;
+
+        CpuTimer() noexcept
+            : m_start{ now() }
         {
         }
 
-        Duration elapsed() const noexcept { return Clock::now() - m_start; }
-        void     reset() noexcept { m_start = Clock::now(); }
+        Duration elapsed() const noexcept { return now() - m_start; }
+        void     reset() noexcept { m_start = now(); }
 
-        TimePoint m_start;
+        static Duration now() noexcept
+        {
+            auto ts = timespec{};
+            ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+            return std::chrono::seconds{ ts.tv_sec } + std::chrono::nanoseconds{ ts.tv_nsec };
+        }
+
+        Duration m_start;
+    };
+
+    enum class LoadMode
+    {
+        Mmap,    // map the file into memory, lines point directly into the mapping
+        Read,    // read the whole file into a buffer in one go
     };
 
     struct RawInput
     {
-        std::string                   m_string;
-        std::vector<std::string_view> m_lines;
+        // neither of the storage relocates its content on move (unlike std::string with SSO), so the lines
+        // span can be moved outside alongside it without invalidating the std::string_view to it
+        std::variant<std::vector<char>, util::MappedFile> m_storage;
+        std::vector<std::string_view>                     m_lines;
     };
 
     template <Day D>
     struct RunResult
     {
         D::Output       m_result;
+        Timer::Duration m_load_time;
         Timer::Duration m_parse_time;
         Timer::Duration m_solve_time;
+
+        // all zero if allocation tracking is not compiled in (see util::alloc_tracking)
+        util::AllocStats m_load_allocs;
+        util::AllocStats m_parse_allocs;
+        util::AllocStats m_solve_allocs;
+
+        // the input was streamed into the solve, load and parse are part of the solve time
+        bool m_streamed = false;
+
+        // the result came from the cache, nothing was parsed nor solved; looking it up is the load time
+        bool m_cached = false;
+
+        // the input was read from its snapshot (see open_snapshot) instead of being parsed
+        bool m_snapshot = false;
+    };
+
+    template <Day D>
+    struct PartResult
+    {
+        D::Output        m_result;
+        Timer::Duration  m_solve_time;
+        util::AllocStats m_solve_allocs;
+    };
+
+    // both parts of a day on a single load and parse of the input
+    template <Day D>
+    struct SessionResult
+    {
+        using Outcome = std::expected<PartResult<D>, std::exception_ptr>;
+
+        Timer::Duration  m_load_time;
+        Timer::Duration  m_parse_time;
+        util::AllocStats m_load_allocs;
+        util::AllocStats m_parse_allocs;
+
+        // a part that throws doesn't take the other one down with it
+        Outcome m_part_one;
+        Outcome m_part_two;
+
+        // each part read the input by itself, load and parse are part of their solve time (and zero here)
+        bool m_streamed = false;
+
+        // both parts were solved in one go (see concepts::SolveBoth), the time is all on part one
+        bool m_combined = false;
+
+        // both results came from the cache, nothing was parsed nor solved; looking them up is the load time
+        bool m_cached = false;
+
+        // the input was read from its snapshot (see open_snapshot) instead of being parsed
+        bool m_snapshot = false;
+    };
+
+    // every single iteration of a benchmarked phase, warm-up iterations excluded
+    struct Measurement
+    {
+        std::vector<Timer::Duration>    m_samples;
+        util::Stats<Timer::Duration>    m_stats;
+        std::optional<util::PerfCounts> m_counters;    // mean per iteration they could be read in
+        util::AllocStats                m_allocs;      // count and bytes: mean per iteration, peak: max
+        std::size_t                     m_warmup;      // iterations
+        std::optional<double>           m_ci;          // relative half-width of the 95% ci of the median, adaptive
+    };
+
+    // what a solution gets through its context besides the flags, and where its results may come from instead
+    struct SolveConfig
+    {
+        util::ThreadPool*  m_workers    = nullptr;    // see Context::parallel_for
+        bool               m_huge_pages = false;      // see util::Arena
+        util::ResultCache* m_cache      = nullptr;    // used by run_solution and run_session only
+    };
+
+    struct BenchConfig
+    {
+        std::size_t       m_repeat;                // the minimum if adaptive
+        bool              m_counters  = false;    // collect hardware performance counters around every iteration
+        util::ClockSource m_clock     = util::ClockSource::Chrono;
+        double            m_target_ci = 0.0;      // adaptive if not 0, see Sampling
+        Timer::Duration   m_budget    = std::chrono::seconds{ 10 };
+    };
+
+    // how many iterations measure() runs. fixed: `m_warmup` then `m_repeat`. adaptive, when there is a target: a
+    // warm-up of at least `m_warmup` that lasts until the samples stop trending down, then samples until the ci of
+    // the median is within the target, at least `m_repeat` of them. the budget bounds an adaptive measurement
+    // unless the minimum number of iterations takes longer than that
+    struct Sampling
+    {
+        std::size_t     m_warmup;
+        std::size_t     m_repeat;
+        double          m_target_ci;    // relative half-width of the 95% bootstrap ci of the median, or 0
+        Timer::Duration m_budget;       // warm-up included
     };
 
     struct BenchResult
     {
-        Timer::Duration m_parse_time;
-        Timer::Duration m_solve_time;
+        Measurement m_load;
+        Measurement m_parse;
+        Measurement m_copy;     // copy of the parsed input, not part of the solve
+        Measurement m_solve;
+
+        // the input was read from its snapshot (see open_snapshot) instead of being parsed
+        bool m_snapshot = false;
     };
 
-    inline RawInput parse_file(const fs::path& path) noexcept
+    struct ColdConfig
     {
-        ASSERT(fs::exists(path), fmt::format("path '{}' must exist when calling this function", path));
+        std::size_t m_runs;
+        bool        m_evict = false;    // evict the input from the page cache and flush the cpu caches before a run
+    };
 
-        // allow raw input (and the lines span) be moved outside without invalidating std::string_view to it
-        auto raw_input = RawInput{};
+    // a one-shot invocation: the whole process from spawn to exit, and the phases of the session it ran
+    struct ColdRun
+    {
+        Timer::Duration m_process;
+        Timer::Duration m_load;
+        Timer::Duration m_parse;
+        Timer::Duration m_solve;    // both parts
+    };
 
-        auto  file         = std::ifstream{ path };
-        auto& file_content = raw_input.m_string;
+    struct ColdResult
+    {
+        ColdRun                      m_first;
+        ColdRun                      m_steady;     // median of the runs after the first, phase by phase
+        ColdRun                      m_hot;        // in this very process after a warm-up, no process time
+        util::Stats<Timer::Duration> m_process;    // of the runs after the first
+    };
 
-        auto lines_view = std::vector<std::pair<std::size_t, std::size_t>>{};
+    struct BatchResult
+    {
+        std::size_t                  m_inputs;       // solved successfully
+        std::size_t                  m_bytes;        // size of the inputs solved successfully
+        Timer::Duration              m_wall_time;    // the whole batch
+        std::vector<Timer::Duration> m_latencies;    // load + parse + both parts, per input
+        util::Stats<Timer::Duration> m_stats;
 
-        auto index = 0uz;
-        auto line  = std::string{};
+        std::vector<std::pair<fs::path, std::string>> m_failures;
+    };
 
-        while (std::getline(file, line)) {
-            file_content += line;    // ignore new line it's not necessary anyway
-            lines_view.emplace_back(index, line.size());
-            index = file_content.size();
+    struct SweepPoint
+    {
+        std::size_t m_size;    // in lines or cells, see truncate_input
+        Measurement m_solve;
+    };
+
+    struct SweepResult
+    {
+        InputShape                       m_shape;
+        std::vector<SweepPoint>          m_points;    // smallest first
+        std::vector<util::ComplexityFit> m_fits;      // of the medians, best first
+    };
+
+    // maximum number of inputs cloned ahead of the benchmarked solve
+    inline constexpr auto clone_pool_size = 32uz;
+
+    // the last iterations of an adaptive warm-up that are looked at for a trend, see util::trend_settled
+    inline constexpr auto warmup_window = 10uz;
+
+    // an adaptive stop checks the ci again once the samples grew by a quarter and by `ci_check_stride` at least;
+    // the ci is bootstrapped from `ci_max_samples` of them at most, `ci_resamples` times
+    inline constexpr auto ci_check_stride = 16uz;
+    inline constexpr auto ci_max_samples  = 512uz;
+    inline constexpr auto ci_resamples    = 500uz;
+
+    // throws std::system_error if the file can't be opened or read
+    inline std::string_view read_into(std::vector<char>& buffer, const fs::path& path)
+    {
+        constexpr auto chunk_size = 64uz * 1024;
+
+        auto ec = std::error_code{};
+        if (auto size = fs::file_size(path, ec); not ec) {
+            buffer.reserve(size);
         }
 
-        auto to_substr = [&](auto&& pair) {
-            auto&& [begin, size] = pair;
-            auto str_begin       = file_content.begin() + static_cast<std::ptrdiff_t>(begin);
-            return std::string_view{ str_begin, str_begin + static_cast<std::ptrdiff_t>(size) };
-        };
+        auto file = std::ifstream{ path, std::ios::binary };
+        if (not file.is_open()) {
+            throw std::system_error{ errno, std::generic_category(), path.string() };
+        }
+
+        while (file) {
+            auto old_size = buffer.size();
+            buffer.resize(old_size + chunk_size);
+            file.read(buffer.data() + old_size, static_cast<std::streamsize>(chunk_size));
+            buffer.resize(old_size + static_cast<std::size_t>(file.gcount()));
+        }
+        if (file.bad()) {
+            throw std::system_error{ std::make_error_code(std::errc::io_error), path.string() };
+        }
+
+        return { buffer.data(), buffer.size() };
+    }
+
+    // like parse_file but reuses the read buffer and the lines of a previous RawInput, returns the content
+    inline std::string_view parse_file_into(RawInput& raw_input, const fs::path& path, LoadMode mode)
+    {
+        AOC_TRACE_SCOPE("load");
+        auto profile = util::profile_phase("load");
+
+        auto content = std::string_view{};
+
+        auto mapped = mode == LoadMode::Mmap ? util::MappedFile::map(path) : std::nullopt;
+        if (mapped.has_value()) {
+            content = raw_input.m_storage.emplace<util::MappedFile>(std::move(*mapped)).view();
+        } else {
+            auto* buffer = std::get_if<std::vector<char>>(&raw_input.m_storage);
+            if (buffer == nullptr) {
+                buffer = &raw_input.m_storage.emplace<std::vector<char>>();
+            }
+            buffer->clear();
+            content = read_into(*buffer, path);
+        }
+
+        raw_input.m_lines.clear();
+        util::index_lines(content, raw_input.m_lines);
+
+        return content;
+    }
 
-        raw_input.m_lines = lines_view | sv::transform(to_substr) | sr::to<std::vector>();
+    // falls back to LoadMode::Read if the file can't be mapped; throws std::system_error if it can't be read
+    // either (it doesn't exist, is not readable, ...)
+    inline RawInput parse_file(const fs::path& path, LoadMode mode = LoadMode::Mmap)
+    {
+        auto raw_input = RawInput{};
+        parse_file_into(raw_input, path, mode);
         return raw_input;
     }
 
+    // next to the text input it's the snapshot of
+    inline fs::path snapshot_path(const fs::path& infile)
+    {
+        auto path  = infile;
+        path      += ".snap";
+        return path;
+    }
+
+    // the snapshot of the parsed `infile` if D can have one and there is one that is not older than `infile`;
+    // when there is, mapping it stands for loading the input and reading the input out of it for parsing
+    template <Day D>
+    std::optional<util::SnapshotReader> open_snapshot(const fs::path& infile)
+    {
+        if constexpr (Snapshotable<D>) {
+            AOC_TRACE_SCOPE("load snapshot");
+            auto profile = util::profile_phase("load");
+
+            auto ec        = std::error_code{};
+            auto path      = snapshot_path(infile);
+            auto text_time = fs::last_write_time(infile, ec);
+            if (ec) {
+                return std::nullopt;
+            }
+            if (auto snapshot_time = fs::last_write_time(path, ec); ec or snapshot_time < text_time) {
+                return std::nullopt;
+            }
+            return util::SnapshotReader::open(path, D::id, D::snapshot_version);
+        }
+        return std::nullopt;
+    }
+
+    inline Context make_context(bool benchmark, const SolveConfig& config, util::Arena& arena)
+    {
+        return {
+#if defined(NDEBUG)
+            .m_debug = false,
+#else
+            .m_debug = true,
+#endif
+            .m_benchmark = benchmark,
+            .m_pool      = config.m_workers,
+            .m_memory    = &arena,
+        };
+    }
+
+    // the hash of the input the cache keys of its results derive from, std::nullopt if there is no cache to look
+    // into, the output of D can't be cached, or the input can't be mapped
+    template <Day D>
+    std::optional<std::uint64_t> cache_input_hash(const SolveConfig& config, const fs::path& infile)
+    {
+        if constexpr (util::Cacheable<typename D::Output>) {
+            if (config.m_cache != nullptr) {
+                return util::ResultCache::hash_file(infile);
+            }
+        }
+        return std::nullopt;
+    }
+
+    template <Day D>
+    std::uint64_t cache_key(std::uint64_t input_hash, Part part)
+    {
+        return util::ResultCache::key(input_hash, D::id, std::to_underlying(part));
+    }
+
+    // read from the snapshot if there is one (from its start, so it can be read again), else parsed from the lines
+    // of `raw_input`. a snapshot that turns out to be damaged is dropped, `infile` is then loaded into `raw_input`
+    // and parsed instead
+    template <Day D>
+    D::Input parse_input(
+        const D&                             day,
+        std::optional<util::SnapshotReader>& snapshot,
+        RawInput&                            raw_input,
+        const fs::path&                      infile,
+        Context                              ctx
+    )
+    {
+        AOC_TRACE_SCOPE("parse");
+        auto profile = util::profile_phase("parse");
+
+        if constexpr (Snapshotable<D>) {
+            if (snapshot.has_value()) {
+                try {
+                    snapshot->rewind();
+                    return day.load_snapshot(*snapshot, ctx);
+                } catch (const util::SnapshotError&) {
+                    snapshot.reset();
+                    raw_input = parse_file(infile);
+                }
+            }
+        }
+        return day.parse(raw_input.m_lines, ctx);
+    }
+
+    // parses `infile` and writes the snapshot of the input next to it, returns the path and the size of the
+    // snapshot; throws std::system_error if it can't be written
+    template <Snapshotable D>
+    std::pair<fs::path, std::size_t> write_snapshot(const D& day, const fs::path& infile)
+    {
+        auto arena   = util::Arena{};
+        auto context = make_context(false, {}, arena);
+        auto writer  = util::SnapshotWriter{};
+
+        auto [_raw_storage, raw_lines] = parse_file(infile);
+        day.save_snapshot(day.parse(raw_lines, context), writer);
+
+        auto path = snapshot_path(infile);
+        if (not writer.save(path, D::id, D::snapshot_version)) {
+            throw std::system_error{ errno, std::generic_category(), path.string() };
+        }
+
+        return { path, writer.size() };
+    }
+
     template <AreDays Days>
     std::vector<std::string_view> generate_solutions_ids()
     {
@@ -120,26 +547,233 @@ namespace aoc::common
         return solution;
     }
 
+    // the input is forwarded as is, see concepts::BorrowingPartOne for the forms a part may take it in
+    template <Part P, Day D, typename In>
+    D::Output solve_part(const D& day, In&& input, Context ctx)
+    {
+        AOC_TRACE_SCOPE(P == Part::One ? "solve part 1" : "solve part 2");
+        auto profile_part  = util::profile_part(P == Part::One ? "part 1" : "part 2");
+        auto profile_phase = util::profile_phase("solve");
+
+        if constexpr (P == Part::One) {
+            return day.solve_part_one(std::forward<In>(input), ctx);
+        } else {
+            return day.solve_part_two(std::forward<In>(input), ctx);
+        }
+    }
+
+    // calls `fn(PartTag<P>{}, input)` for both parts with the input in the cheapest form: a part that borrows it
+    // goes first with a const reference, then the other part gets the input itself; a copy is only made if
+    // neither part borrows. returns the results of part one and part two, in that order
+    template <Day D, typename Fn>
+    auto share_input(typename D::Input&& input, Fn&& fn)
+    {
+        using One    = PartTag<Part::One>;
+        using Two    = PartTag<Part::Two>;
+        using Result = std::invoke_result_t<Fn&, One, typename D::Input&&>;
+
+        if constexpr (BorrowingPartOne<D>) {
+            auto one = fn(One{}, std::as_const(input));
+            auto two = fn(Two{}, std::move(input));
+            return std::pair<Result, Result>{ std::move(one), std::move(two) };
+        } else if constexpr (BorrowingPartTwo<D>) {
+            auto two = fn(Two{}, std::as_const(input));
+            auto one = fn(One{}, std::move(input));
+            return std::pair<Result, Result>{ std::move(one), std::move(two) };
+        } else {
+            auto one = fn(One{}, typename D::Input{ input });
+            auto two = fn(Two{}, std::move(input));
+            return std::pair<Result, Result>{ std::move(one), std::move(two) };
+        }
+    }
+
+    // like share_input, but both parts are solved side by side on `pool` (see util::parallel_for, the calling
+    // thread takes a part too). as they run at once, only a part that borrows can share the input itself; unless
+    // both borrow, a copy is made for part one before either part starts
+    template <Day D, typename Fn>
+    auto share_input_parallel(typename D::Input&& input, util::ThreadPool* pool, Fn&& fn)
+    {
+        using One    = PartTag<Part::One>;
+        using Two    = PartTag<Part::Two>;
+        using Result = std::invoke_result_t<Fn&, One, typename D::Input&&>;
+
+        auto one  = std::optional<Result>{};
+        auto two  = std::optional<Result>{};
+        auto both = [&](auto&& solve_one, auto&& solve_two) {
+            util::parallel_for(pool, 2, [&](std::size_t begin, std::size_t end) {
+                for (auto i = begin; i < end; ++i) {
+                    if (i == 0) {
+                        one.emplace(solve_one());
+                    } else {
+                        two.emplace(solve_two());
+                    }
+                }
+            });
+            return std::pair<Result, Result>{ std::move(*one), std::move(*two) };
+        };
+
+        if constexpr (BorrowingPartOne<D> and BorrowingPartTwo<D>) {
+            return both(
+                [&] { return fn(One{}, std::as_const(input)); },    //
+                [&] { return fn(Two{}, std::as_const(input)); }
+            );
+        } else {
+            auto copy = typename D::Input{ input };
+            return both(
+                [&] { return fn(One{}, std::move(copy)); },    //
+                [&] { return fn(Two{}, std::move(input)); }
+            );
+        }
+    }
+
+    // feeds every line of `reader` to `sink` up to the end of its input; `source` names the input in the error
+    // thrown if it can't be read
+    template <Day D, LineSink<typename D::Output> Sink>
+    RunResult<D> stream_solution(util::LineReader reader, std::string_view source, Sink sink)
+    {
+        AOC_TRACE_SCOPE("stream");
+        auto profile = util::profile_phase("stream");
+
+        auto allocs = util::AllocScope{};
+        auto timer  = Timer{};
+
+        if (auto err = reader.for_each_line([&](std::string_view line) { sink.feed(line); }); err != 0) {
+            throw std::system_error{ err, std::generic_category(), std::string{ source } };
+        }
+
+        auto output       = std::move(sink).finish();
+        auto solve_time   = timer.elapsed();
+        auto solve_allocs = allocs.stop();
+
+        return {
+            .m_result       = std::move(output),
+            .m_load_time    = {},
+            .m_parse_time   = {},
+            .m_solve_time   = solve_time,
+            .m_load_allocs  = {},
+            .m_parse_allocs = {},
+            .m_solve_allocs = solve_allocs,
+            .m_streamed     = true,
+            .m_cached       = false,
+            .m_snapshot     = false,
+        };
+    }
+
+    template <Day D, LineSink<typename D::Output> Sink>
+    RunResult<D> stream_solution(const fs::path& infile, Sink sink)
+    {
+        auto reader = util::LineReader::open(infile);
+        if (not reader) {
+            throw std::system_error{ errno, std::generic_category(), infile.string() };
+        }
+        return stream_solution<D>(std::move(*reader), infile.string(), std::move(sink));
+    }
+
+    // solves `part` on the input read from `fd` (stdin, a pipe) up to its end, without ever holding all of it;
+    // the descriptor is left open. std::nullopt if that part of D can't be streamed (see StreamingPartOne)
     template <Day D>
-    RunResult<D> run_solution(const D& day, const fs::path& infile, Part part)
+    std::optional<RunResult<D>> stream_fd_solution(
+        const D&           day,
+        int                fd,
+        Part               part,
+        const SolveConfig& solve_config = {}
+    )
     {
-        auto timer                 = Timer{};
-        auto [_raw_str, raw_lines] = parse_file(infile);
+        auto profile_day  = util::profile_day(D::name);
+        auto profile_part = util::profile_part(part == Part::One ? "part 1" : "part 2");
 
-        auto context = Context{
-#if defined(NDEBUG)
-            .m_debug = false,
-#else
-            .m_debug = true,
-#endif
-            .m_benchmark = false,
+        auto arena   = util::Arena{ solve_config.m_huge_pages };
+        auto context = make_context(false, solve_config, arena);
+        auto source  = fmt::format("fd {}", fd);
+
+        if constexpr (StreamingPartOne<D>) {
+            if (part == Part::One) {
+                return stream_solution<D>(util::LineReader::borrow(fd), source, day.stream_part_one(context));
+            }
+        }
+        if constexpr (StreamingPartTwo<D>) {
+            if (part == Part::Two) {
+                return stream_solution<D>(util::LineReader::borrow(fd), source, day.stream_part_two(context));
+            }
+        }
+        return std::nullopt;
+    }
+
+    template <Day D>
+    RunResult<D> run_solution(
+        const D&           day,
+        const fs::path&    infile,
+        Part               part,
+        const SolveConfig& solve_config = {}
+    )
+    {
+        auto profile_day  = util::profile_day(D::name);
+        auto profile_part = util::profile_part(part == Part::One ? "part 1" : "part 2");
+
+        auto arena   = util::Arena{ solve_config.m_huge_pages };
+        auto context = make_context(false, solve_config, arena);
+
+        auto cache_timer = Timer{};
+        auto input_hash  = cache_input_hash<D>(solve_config, infile);
+
+        if constexpr (util::Cacheable<typename D::Output>) {
+            if (input_hash.has_value()) {
+                auto cached = solve_config.m_cache->load<typename D::Output>(cache_key<D>(*input_hash, part));
+                if (cached.has_value()) {
+                    return {
+                        .m_result       = *cached,
+                        .m_load_time    = cache_timer.elapsed(),
+                        .m_parse_time   = {},
+                        .m_solve_time   = {},
+                        .m_load_allocs  = {},
+                        .m_parse_allocs = {},
+                        .m_solve_allocs = {},
+                        .m_streamed     = false,
+                        .m_cached       = true,
+                        .m_snapshot     = false,
+                    };
+                }
+            }
+        }
+
+        auto remember = [&](RunResult<D> result) {
+            if constexpr (util::Cacheable<typename D::Output>) {
+                if (input_hash.has_value()) {
+                    solve_config.m_cache->store(cache_key<D>(*input_hash, part), result.m_result);
+                }
+            }
+            return result;
         };
 
+        // a part that can be streamed never has the whole input in memory
+        if constexpr (StreamingPartOne<D>) {
+            if (part == Part::One) {
+                return remember(stream_solution<D>(infile, day.stream_part_one(context)));
+            }
+        }
+        if constexpr (StreamingPartTwo<D>) {
+            if (part == Part::Two) {
+                return remember(stream_solution<D>(infile, day.stream_part_two(context)));
+            }
+        }
+
+        auto allocs      = util::AllocScope{};
+        auto timer       = Timer{};
+        auto snapshot    = open_snapshot<D>(infile);
+        auto raw_input   = snapshot.has_value() ? RawInput{} : parse_file(infile);
+        auto load_time   = timer.elapsed();
+        auto load_allocs = allocs.stop();
+
+        allocs = util::AllocScope{};
         timer.reset();
-        auto input      = day.parse(raw_lines, context);
-        auto parse_time = timer.elapsed();
+        auto input        = parse_input(day, snapshot, raw_input, infile, context);
+        auto parse_time   = timer.elapsed();
+        auto parse_allocs = allocs.stop();
 
         auto solve = [&] {
+            AOC_TRACE_SCOPE(part == Part::One ? "solve part 1" : "solve part 2");
+            auto profile = util::profile_phase("solve");
+
             switch (part) {
             case Part::One: return day.solve_part_one(std::move(input), context); break;
             case Part::Two: return day.solve_part_two(std::move(input), context); break;
@@ -147,72 +781,797 @@ namespace aoc::common
             }
         };
 
+        allocs = util::AllocScope{};
         timer.reset();
-        auto output     = solve();
-        auto solve_time = timer.elapsed();
+        auto output       = solve();
+        auto solve_time   = timer.elapsed();
+        auto solve_allocs = allocs.stop();
+
+        return remember({
+            .m_result       = std::move(output),
+            .m_load_time    = load_time,
+            .m_parse_time   = parse_time,
+            .m_solve_time   = solve_time,
+            .m_load_allocs  = load_allocs,
+            .m_parse_allocs = parse_allocs,
+            .m_solve_allocs = solve_allocs,
+            .m_streamed     = false,
+            .m_cached       = false,
+            .m_snapshot     = snapshot.has_value(),
+        });
+    }
+
+    // like run_solution for both parts, except that the input is only loaded and parsed once and then shared
+    // between the parts (see share_input, a copy is made outside of the solve time), unless the day solves both
+    // parts at once. with a pool the parts are solved side by side, each on an arena of its own (see
+    // share_input_parallel)
+    template <Day D>
+    SessionResult<D> run_session(
+        const D&           day,
+        const fs::path&    infile,
+        const SolveConfig& solve_config = {},
+        util::ThreadPool*  pool         = nullptr
+    )
+    {
+        AOC_TRACE_SCOPE(D::name);
+        auto profile = util::profile_day(D::name);
+
+        using Outcome = SessionResult<D>::Outcome;
+
+        auto arena   = util::Arena{ solve_config.m_huge_pages };
+        auto context = make_context(false, solve_config, arena);
+
+        auto attempt = [](auto&& fn) -> Outcome {
+            try {
+                return fn();
+            } catch (...) {
+                return std::unexpected{ std::current_exception() };
+            }
+        };
+
+        auto cache_timer = Timer{};
+        auto input_hash  = cache_input_hash<D>(solve_config, infile);
+
+        // only a hit on both parts skips the parse, which is the expensive part for most days
+        if constexpr (util::Cacheable<typename D::Output>) {
+            if (input_hash.has_value()) {
+                auto lookup = [&](Part part) {
+                    return solve_config.m_cache->load<typename D::Output>(cache_key<D>(*input_hash, part));
+                };
+                auto cached = [](D::Output output) {
+                    return PartResult<D>{ .m_result = output, .m_solve_time = {}, .m_solve_allocs = {} };
+                };
+
+                auto one = lookup(Part::One);
+                auto two = one.has_value() ? lookup(Part::Two) : std::nullopt;
+
+                if (one.has_value() and two.has_value()) {
+                    return {
+                        .m_load_time    = cache_timer.elapsed(),
+                        .m_parse_time   = {},
+                        .m_load_allocs  = {},
+                        .m_parse_allocs = {},
+                        .m_part_one     = cached(*one),
+                        .m_part_two     = cached(*two),
+                        .m_streamed     = false,
+                        .m_combined     = false,
+                        .m_cached       = true,
+                        .m_snapshot     = false,
+                    };
+                }
+            }
+        }
+
+        auto remember = [&](SessionResult<D> result) {
+            if constexpr (util::Cacheable<typename D::Output>) {
+                if (input_hash.has_value()) {
+                    if (result.m_part_one.has_value()) {
+                        auto key = cache_key<D>(*input_hash, Part::One);
+                        solve_config.m_cache->store(key, result.m_part_one->m_result);
+                    }
+                    if (result.m_part_two.has_value()) {
+                        auto key = cache_key<D>(*input_hash, Part::Two);
+                        solve_config.m_cache->store(key, result.m_part_two->m_result);
+                    }
+                }
+            }
+            return result;
+        };
+
+        // there is nothing to share when both parts can be streamed, each reads the input on its own
+        if constexpr (StreamingPartOne<D> and StreamingPartTwo<D>) {
+            auto stream = [&](auto sink) {
+                auto result = stream_solution<D>(infile, std::move(sink));
+                return PartResult<D>{
+                    .m_result       = std::move(result.m_result),
+                    .m_solve_time   = result.m_solve_time,
+                    .m_solve_allocs = result.m_solve_allocs,
+                };
+            };
+
+            return remember({
+                .m_load_time    = {},
+                .m_parse_time   = {},
+                .m_load_allocs  = {},
+                .m_parse_allocs = {},
+                .m_part_one     = attempt([&] { return stream(day.stream_part_one(context)); }),
+                .m_part_two     = attempt([&] { return stream(day.stream_part_two(context)); }),
+                .m_streamed     = true,
+                .m_combined     = false,
+                .m_cached       = false,
+                .m_snapshot     = false,
+            });
+        } else {
+            auto allocs      = util::AllocScope{};
+            auto timer       = Timer{};
+            auto snapshot    = open_snapshot<D>(infile);
+            auto raw_input   = snapshot.has_value() ? RawInput{} : parse_file(infile);
+            auto load_time   = timer.elapsed();
+            auto load_allocs = allocs.stop();
+
+            allocs = util::AllocScope{};
+            timer.reset();
+            auto input        = parse_input(day, snapshot, raw_input, infile, context);
+            auto parse_time   = timer.elapsed();
+            auto parse_allocs = allocs.stop();
+
+            auto solve = [&](auto&& fn) {
+                auto allocs = util::AllocScope{};
+                auto timer  = Timer{};
+                auto output = fn();
+
+                return PartResult<D>{
+                    .m_result       = std::move(output),
+                    .m_solve_time   = timer.elapsed(),
+                    .m_solve_allocs = allocs.stop(),
+                };
+            };
+
+            auto [part_one, part_two] = [&]() -> std::pair<Outcome, Outcome> {
+                if constexpr (SolveBoth<D>) {
+                    try {
+                        AOC_TRACE_SCOPE("solve both");
+                        auto profile_part  = util::profile_part("both");
+                        auto profile_phase = util::profile_phase("solve");
+
+                        auto allocs     = util::AllocScope{};
+                        auto timer      = Timer{};
+                        auto [one, two] = day.solve_both(std::move(input), context);
+
+                        auto both = PartResult<D>{
+                            .m_result       = std::move(one),
+                            .m_solve_time   = timer.elapsed(),
+                            .m_solve_allocs = allocs.stop(),
+                        };
+                        auto second = PartResult<D>{
+                            .m_result       = std::move(two),
+                            .m_solve_time   = {},
+                            .m_solve_allocs = {},
+                        };
+
+                        return { std::move(both), std::move(second) };
+                    } catch (...) {
+                        auto error = std::unexpected{ std::current_exception() };
+                        return { error, error };
+                    }
+                } else if (pool != nullptr) {
+                    // the arenas are not thread-safe, part two gets its own
+                    auto arena_two   = util::Arena{ solve_config.m_huge_pages };
+                    auto context_two = make_context(false, solve_config, arena_two);
+
+                    return share_input_parallel<D>(std::move(input), pool, [&]<Part P>(PartTag<P>, auto&& in) {
+                        return attempt([&] {
+                            auto ctx = P == Part::One ? context : context_two;
+                            auto fn  = [&] { return solve_part<P>(day, std::forward<decltype(in)>(in), ctx); };
+                            return solve(fn);
+                        });
+                    });
+                } else {
+                    return share_input<D>(std::move(input), [&]<Part P>(PartTag<P>, auto&& in) {
+                        return attempt([&] {
+                            auto fn = [&] { return solve_part<P>(day, std::forward<decltype(in)>(in), context); };
+                            return solve(fn);
+                        });
+                    });
+                }
+            }();
+
+            return remember({
+                .m_load_time    = load_time,
+                .m_parse_time   = parse_time,
+                .m_load_allocs  = load_allocs,
+                .m_parse_allocs = parse_allocs,
+                .m_part_one     = std::move(part_one),
+                .m_part_two     = std::move(part_two),
+                .m_streamed     = false,
+                .m_combined     = SolveBoth<D>,
+                .m_cached       = false,
+                .m_snapshot     = snapshot.has_value(),
+            });
+        }
+    }
+
+    // relative half-width of the 95% bootstrap ci of the median of the samples. past ci_max_samples an evenly
+    // strided subset is bootstrapped and its ci scaled by sqrt(subset / all), a median's ci going as 1/sqrt(n)
+    inline double median_ci(std::span<const Timer::Duration> samples)
+    {
+        auto stride = (samples.size() + ci_max_samples - 1) / ci_max_samples;
+        auto values = std::vector<double>{};
+        values.reserve(ci_max_samples);
+        for (auto i = 0uz; i < samples.size(); i += stride) {
+            values.push_back(static_cast<double>(samples[i].count()));
+        }
+
+        auto median   = util::median_of(values);
+        auto [lo, hi] = util::bootstrap_median_ci(values, 0.95, ci_resamples);
+        auto scale    = std::sqrt(static_cast<double>(values.size()) / static_cast<double>(samples.size()));
+        return median > 0.0 ? (hi - lo) / 2.0 / median * scale : 0.0;
+    }
+
+    // `fn` times a single iteration itself and returns its duration; `prepare` is called before every iteration
+    // (warm-up included) outside of the measured region and its result is passed into `fn`
+    template <std::invocable Prepare, std::invocable<std::invoke_result_t<Prepare>> Fn>
+    Measurement measure(Prepare&& prepare, Fn&& fn, const Sampling& sampling, util::PerfCounters* counters)
+    {
+        auto adaptive = sampling.m_target_ci > 0.0;
+        auto budget   = Timer{};
+
+        // an adaptive warm-up gets half of the budget at most
+        auto warmup = std::vector<double>{};
+        auto warmed = [&] {
+            if (warmup.size() < sampling.m_warmup) {
+                return false;
+            } else if (not adaptive or budget.elapsed() >= sampling.m_budget / 2) {
+                return true;
+            }
+            auto recent = std::span{ warmup }.last(std::min(warmup.size(), warmup_window));
+            return recent.size() == warmup_window and util::trend_settled(recent);
+        };
+
+        while (not warmed()) {
+            warmup.push_back(static_cast<double>(fn(prepare()).count()));
+        }
+
+        auto samples = std::vector<Timer::Duration>{};
+        samples.reserve(sampling.m_repeat);
+
+        // checked on a geometric schedule, a bench of n samples bootstraps O(log n) times only
+        auto next_check = sampling.m_repeat;
+        auto done       = [&] {
+            if (samples.size() < sampling.m_repeat) {
+                return false;
+            } else if (not adaptive or budget.elapsed() >= sampling.m_budget) {
+                return true;
+            } else if (samples.size() < next_check) {
+                return false;
+            }
+            next_check = samples.size() + std::max(samples.size() / 4, ci_check_stride);
+            return median_ci(samples) <= sampling.m_target_ci;
+        };
+
+        // only the iterations whose counters could all be read are averaged
+        auto counts  = util::PerfCounts{};
+        auto counted = 0uz;
+        auto allocs  = util::AllocStats{};
+
+        while (not done()) {
+            auto arg   = prepare();
+            auto scope = util::AllocScope{};
+
+            if (counters != nullptr) {
+                counters->start();
+                samples.push_back(fn(std::move(arg)));
+                if (auto read = counters->stop()) {
+                    counts += *read;
+                    ++counted;
+                }
+            } else {
+                samples.push_back(fn(std::move(arg)));
+            }
+
+            if constexpr (util::alloc_tracking) {
+                auto [count, bytes, peak]  = scope.stop();
+                allocs.m_count            += count;
+                allocs.m_bytes            += bytes;
+                allocs.m_peak              = std::max(allocs.m_peak, peak);
+            }
+        }
+
+        auto stats = util::compute_stats<Timer::Duration>(samples);
+        auto mean  = counted > 0 ? std::optional{ counts / static_cast<double>(counted) } : std::nullopt;
+        auto ci    = adaptive ? std::optional{ median_ci(samples) } : std::nullopt;
+
+        allocs.m_count /= samples.size();
+        allocs.m_bytes /= samples.size();
 
         return {
-            .m_result     = std::move(output),
-            .m_parse_time = parse_time,
-            .m_solve_time = solve_time,
+            .m_samples  = std::move(samples),
+            .m_stats    = std::move(stats),
+            .m_counters = mean,
+            .m_allocs   = allocs,
+            .m_warmup   = warmup.size(),
+            .m_ci       = ci,
         };
     }
 
+    template <std::invocable Fn>
+    Measurement measure(Fn&& fn, const Sampling& sampling, util::PerfCounters* counters)
+    {
+        auto prepare = [] { return aliases::unit{}; };
+        return measure(prepare, [&](aliases::unit) { return fn(); }, sampling, counters);
+    }
+
     template <Day D>
-    BenchResult bench_solution(const D& day, const fs::path& infile, Part part, std::size_t repeat)
+    BenchResult bench_solution(
+        const D&           day,
+        const fs::path&    infile,
+        Part               part,
+        const BenchConfig& config,
+        const SolveConfig& solve_config = {}
+    )
     {
+        AOC_TRACE_SCOPE(D::name);
+        auto profile = util::profile_day(D::name);
+
+        const auto repeat = config.m_repeat;
         if (repeat < 3) {
             throw std::logic_error{ "repeating less than 3 is not very useful for benchmarking..." };
         }
 
-        auto timer                 = Timer{};
-        auto [_raw_str, raw_lines] = parse_file(infile);
+        auto timer     = Timer{ config.m_clock };
+        auto snapshot  = open_snapshot<D>(infile);
+        auto raw_input = snapshot.has_value() ? RawInput{} : parse_file(infile);
 
-        auto context = Context{
-#if defined(NDEBUG)
-            .m_debug = false,
-#else
-            .m_debug = true,
-#endif
-            .m_benchmark = true,
+        // released after every iteration, the input kept for the solve is parsed into its own arena instead
+        auto arena   = util::Arena{ solve_config.m_huge_pages };
+        auto context = make_context(true, solve_config, arena);
+
+        // a damaged snapshot is dropped for the text input on its first read, before anything is measured
+        if (snapshot.has_value()) {
+            std::ignore = parse_input(day, snapshot, raw_input, infile, context);
+            arena.reset();
+        }
+
+        // file load + line indexing, or the mapping of the snapshot; the unmapping/freeing is not measured
+        auto bench_load = [&] {
+            if (snapshot.has_value()) {
+                timer.reset();
+                auto _ = open_snapshot<D>(infile);
+                return timer.elapsed();
+            }
+            timer.reset();
+            auto _ = parse_file(infile);
+            return timer.elapsed();
         };
 
         auto bench_parse = [&] {
+            auto elapsed = Timer::Duration{};
+            {
+                timer.reset();
+                auto _  = parse_input(day, snapshot, raw_input, infile, context);
+                elapsed = timer.elapsed();
+            }
+            arena.reset();
+            return elapsed;
+        };
+
+        // only the deep copy of the input, which a part that doesn't borrow its input would otherwise do on every
+        // iteration
+        auto bench_copy = [&](const D::Input& input) {
             timer.reset();
-            auto _ = day.parse(raw_lines, context);
+            auto _ = input;
             return timer.elapsed();
         };
 
-        auto bench_solve = [&](const D::Input& input) {
+        auto bench_solve = [&]<Part P>(PartTag<P>, auto&& input) {
             timer.reset();
-            switch (part) {
-            case Part::One: day.solve_part_one(input, context); break;    // copy input
-            case Part::Two: day.solve_part_two(input, context); break;    // copy input
-            default: [[unlikely]]; std::unreachable();
+            std::ignore  = solve_part<P>(day, std::forward<decltype(input)>(input), context);
+            auto elapsed = timer.elapsed();
+            arena.reset();
+            return elapsed;
+        };
+
+        auto sampling = Sampling{
+            .m_warmup    = 3,
+            .m_repeat    = repeat,
+            .m_target_ci = config.m_target_ci,
+            .m_budget    = config.m_budget,
+        };
+
+        // timing-only if the counters are not requested or can't be opened; the workers are counted too
+        auto* pool         = solve_config.m_workers;
+        auto  workers      = pool != nullptr ? pool->thread_ids() : std::span<const pid_t>{};
+        auto  counters     = config.m_counters ? util::PerfCounters::open(nullptr, workers) : std::nullopt;
+        auto* counters_ptr = counters.has_value() ? &*counters : nullptr;
+
+        auto load  = measure(bench_load, sampling, counters_ptr);
+        auto parse = measure(bench_parse, sampling, counters_ptr);
+
+        // the copies don't propagate the arena (pmr containers fall back to the default resource on copy)
+        auto input_arena = util::Arena{ solve_config.m_huge_pages };
+        auto input_ctx   = make_context(true, solve_config, input_arena);
+        auto input       = parse_input(day, snapshot, raw_input, infile, input_ctx);
+        auto copy        = measure([&] { return bench_copy(input); }, sampling, counters_ptr);
+
+        // a part that borrows its input gets the same one on every iteration, the others get their own clone
+        auto bench_part = [&]<Part P>(PartTag<P> tag) {
+            if constexpr (P == Part::One ? BorrowingPartOne<D> : BorrowingPartTwo<D>) {
+                auto borrow = [&] { return bench_solve(tag, std::as_const(input)); };
+                return measure(borrow, sampling, counters_ptr);
+            } else {
+                // the clones are made in batches outside of the measured region then moved into the solve; a
+                // bounded pool instead of one clone per iteration so that a big input repeated many times doesn't
+                // exhaust memory
+                auto clones     = std::vector<typename D::Input>{};
+                auto next_clone = [&] {
+                    if (clones.empty()) {
+                        clones.assign(std::min(clone_pool_size, sampling.m_warmup + repeat), input);
+                    }
+                    auto clone = std::move(clones.back());
+                    clones.pop_back();
+                    return clone;
+                };
+
+                auto consume = [&](D::Input&& clone) { return bench_solve(tag, std::move(clone)); };
+                return measure(next_clone, consume, sampling, counters_ptr);
             }
-            return timer.elapsed();
         };
 
-        constexpr auto warmup = 3uz;
+        auto solve = part == Part::One ? bench_part(PartTag<Part::One>{}) : bench_part(PartTag<Part::Two>{});
 
-        auto parse_time = Timer::Duration{};
-        for (auto _ : sv::iota(0uz, warmup)) {
-            std::ignore = bench_parse();
+        return {
+            .m_load     = std::move(load),
+            .m_parse    = std::move(parse),
+            .m_copy     = std::move(copy),
+            .m_solve    = std::move(solve),
+            .m_snapshot = snapshot.has_value(),
+        };
+    }
+
+    // the lines of an input cut down to about `fraction` of its size, and that size: the lines of its last
+    // section for InputShape::Lines, the cells for InputShape::Grid (whose sub-rectangle keeps the aspect ratio,
+    // or only cuts the lines short if there is a single one). the lines point into `lines`; trailing blank lines
+    // are dropped, they would make an empty last section
+    inline std::pair<std::vector<std::string_view>, std::size_t> truncate_input(
+        Lines      lines,
+        InputShape shape,
+        double     fraction
+    )
+    {
+        // at least one of `count`, unless there is none
+        auto scaled = [](std::size_t count, double fraction) {
+            auto n = static_cast<std::size_t>(std::ceil(static_cast<double>(count) * fraction));
+            return std::min(std::max(n, 1uz), count);
+        };
+
+        while (not lines.empty() and lines.back().empty()) {
+            lines = lines.first(lines.size() - 1);
+        }
+
+        auto truncated = std::vector<std::string_view>{};
+        if (lines.empty()) {
+            return { std::move(truncated), 0 };
+        }
+
+        if (shape == InputShape::Lines) {
+            auto section = lines.size();    // where the last section starts
+            while (section > 0 and not lines[section - 1].empty()) {
+                --section;
+            }
+            auto kept = scaled(lines.size() - section, fraction);
+            ASSERT(section + kept <= lines.size());
+
+            truncated.assign(lines.begin(), lines.begin() + static_cast<std::ptrdiff_t>(section + kept));
+            return { std::move(truncated), kept };
+        }
+
+        auto height = lines.size();
+        auto width  = sr::max(lines | sv::transform([](std::string_view line) { return line.size(); }));
+        auto rows   = scaled(height, std::sqrt(fraction));
+        auto cols   = scaled(width, fraction * static_cast<double>(height) / static_cast<double>(rows));
+
+        for (auto line : lines.first(rows)) {
+            truncated.push_back(line.substr(0, cols));
+        }
+        return { std::move(truncated), rows * cols };
+    }
+
+    // benchmarks the solve of `part` on `steps` truncations of `infile` (see truncate_input), from 1/2^(steps - 1)
+    // of its size up to the whole of it, then fits the medians to the usual complexities. the parse is not
+    // measured, the input is always parsed from the text (never read from a snapshot); a size that is the same
+    // as the one before it (a tiny input can't be cut down as far) is skipped
+    template <Sweepable D>
+    SweepResult sweep_solution(
+        const D&           day,
+        const fs::path&    infile,
+        Part               part,
+        std::size_t        steps,
+        const BenchConfig& config,
+        const SolveConfig& solve_config = {}
+    )
+    {
+        AOC_TRACE_SCOPE(D::name);
+        auto profile = util::profile_day(D::name);
+
+        if (config.m_repeat < 3) {
+            throw std::logic_error{ "repeating less than 3 is not very useful for benchmarking..." };
+        }
+
+        auto timer     = Timer{ config.m_clock };
+        auto raw_input = parse_file(infile);
+
+        auto arena   = util::Arena{ solve_config.m_huge_pages };
+        auto context = make_context(true, solve_config, arena);
+
+        auto sampling = Sampling{
+            .m_warmup    = 3,
+            .m_repeat    = config.m_repeat,
+            .m_target_ci = config.m_target_ci,
+            .m_budget    = config.m_budget,
+        };
+
+        auto bench_solve = [&]<Part P>(PartTag<P>, auto&& input) {
+            timer.reset();
+            std::ignore  = solve_part<P>(day, std::forward<decltype(input)>(input), context);
+            auto elapsed = timer.elapsed();
+            arena.reset();
+            return elapsed;
+        };
+
+        // a clone per iteration for a part that consumes its input, made outside of the measured region
+        auto bench_part = [&]<Part P>(PartTag<P> tag, const D::Input& input) {
+            if constexpr (P == Part::One ? BorrowingPartOne<D> : BorrowingPartTwo<D>) {
+                return measure([&] { return bench_solve(tag, input); }, sampling, nullptr);
+            } else {
+                auto clone   = [&] { return input; };
+                auto consume = [&](D::Input&& clone) { return bench_solve(tag, std::move(clone)); };
+                return measure(clone, consume, sampling, nullptr);
+            }
+        };
+
+        auto result = SweepResult{ .m_shape = D::input_shape, .m_points = {}, .m_fits = {} };
+
+        for (auto step = steps; step-- > 0;) {
+            auto fraction      = std::ldexp(1.0, -static_cast<int>(step));
+            auto [lines, size] = truncate_input(raw_input.m_lines, D::input_shape, fraction);
+            if (not result.m_points.empty() and result.m_points.back().m_size == size) {
+                continue;
+            }
+
+            // the copies don't propagate the arena, same as in bench_solution
+            auto input_arena = util::Arena{ solve_config.m_huge_pages };
+            auto input_ctx   = make_context(true, solve_config, input_arena);
+            auto input       = day.parse(lines, input_ctx);
+
+            auto solve = part == Part::One ? bench_part(PartTag<Part::One>{}, input)
+                                           : bench_part(PartTag<Part::Two>{}, input);
+
+            result.m_points.push_back({ .m_size = size, .m_solve = std::move(solve) });
+        }
+
+        auto sizes = std::vector<double>{};
+        auto times = std::vector<double>{};
+        for (const auto& [size, solve] : result.m_points) {
+            sizes.push_back(static_cast<double>(size));
+            times.push_back(std::max(static_cast<double>(solve.m_stats.m_median.count()), 1.0));
+        }
+        result.m_fits = util::fit_complexity(sizes, times);
+
+        return result;
+    }
+
+    // solve both parts of every file in `dir`, spread on the pool if there is one. a file that can't be read (a
+    // dangling symlink, no permission, ...), is empty, or makes the solution throw is a failure of that file, the
+    // rest of the batch goes on. the days reject a malformed input with ASSERT though, which aborts the process:
+    // only the inputs that a day accepts can be batched together
+    template <Day D>
+    BatchResult batch_solution(
+        const D&           day,
+        const fs::path&    dir,
+        util::ThreadPool*  pool,
+        const SolveConfig& solve_config = {}
+    )
+    {
+        auto files = std::vector<fs::path>{};
+        for (const auto& entry : fs::directory_iterator{ dir }) {
+            if (not entry.is_directory()) {
+                files.push_back(entry.path());
+            }
+        }
+        sr::sort(files);
+
+        struct Shard
+        {
+            std::vector<Timer::Duration>                  m_latencies;
+            std::size_t                                   m_bytes = 0;
+            std::vector<std::pair<fs::path, std::string>> m_failures;
+        };
+
+        // the files are handed out one at a time so a slow input doesn't hold back a whole shard; the loaded
+        // content and the lines are read into the same buffers for every file of a shard
+        auto next      = std::atomic<std::size_t>{ 0 };
+        auto run_shard = [&] {
+            auto shard     = Shard{};
+            auto raw_input = RawInput{};
+            auto arena     = util::Arena{ solve_config.m_huge_pages };
+            auto context   = make_context(false, solve_config, arena);
+
+            for (auto i = next++; i < files.size(); i = next++) {
+                AOC_TRACE_SCOPE(D::name);
+                auto profile = util::profile_day(D::name);
+
+                try {
+                    auto timer   = Timer{};
+                    auto content = parse_file_into(raw_input, files[i], LoadMode::Read);
+                    if (raw_input.m_lines.empty()) {
+                        throw std::runtime_error{ "empty input" };
+                    }
+                    auto input = day.parse(raw_input.m_lines, context);
+
+                    if constexpr (SolveBoth<D>) {
+                        std::ignore = day.solve_both(std::move(input), context);
+                    } else {
+                        std::ignore = share_input<D>(std::move(input), [&]<Part P>(PartTag<P>, auto&& in) {
+                            return solve_part<P>(day, std::forward<decltype(in)>(in), context);
+                        });
+                    }
+
+                    shard.m_latencies.push_back(timer.elapsed());
+                    shard.m_bytes += content.size();
+                } catch (std::exception& e) {
+                    shard.m_failures.emplace_back(files[i], e.what());
+                }
+                arena.reset();
+            }
+
+            return shard;
+        };
+
+        auto timer  = Timer{};
+        auto shards = std::vector<Shard>{};
+
+        if (pool != nullptr) {
+            auto futures = std::vector<std::future<Shard>>{};
+            for (auto _ : sv::iota(0uz, std::min(pool->size(), files.size()))) {
+                futures.push_back(pool->submit(run_shard));
+            }
+            for (auto& future : futures) {
+                shards.push_back(future.get());
+            }
+        } else {
+            shards.push_back(run_shard());
         }
-        for (auto _ : sv::iota(0uz, repeat)) {
-            parse_time += bench_parse();
+
+        auto result        = BatchResult{};
+        result.m_wall_time = timer.elapsed();
+
+        for (auto& shard : shards) {
+            result.m_bytes += shard.m_bytes;
+            sr::move(shard.m_latencies, std::back_inserter(result.m_latencies));
+            sr::move(shard.m_failures, std::back_inserter(result.m_failures));
         }
+        sr::sort(result.m_failures);
+
+        result.m_inputs = result.m_latencies.size();
+        result.m_stats  = util::compute_stats<Timer::Duration>(result.m_latencies);
+
+        return result;
+    }
 
-        auto input      = day.parse(raw_lines, context);
-        auto solve_time = Timer::Duration{};
-        for (auto _ : sv::iota(0uz, warmup)) {
-            std::ignore = bench_solve(input);
+    // load, parse and the solve of both parts
+    template <Day D>
+    ColdRun session_phases(const SessionResult<D>& result)
+    {
+        auto solve = Timer::Duration{};
+        for (const auto* part : { &result.m_part_one, &result.m_part_two }) {
+            solve += part->has_value() ? (*part)->m_solve_time : Timer::Duration{};
         }
-        for (auto _ : sv::iota(0uz, repeat)) {
-            solve_time += bench_solve(input);
+
+        return {
+            .m_process = {},
+            .m_load    = result.m_load_time,
+            .m_parse   = result.m_parse_time,
+            .m_solve   = solve,
+        };
+    }
+
+    // the line a child spawned by cold_solution prints for the session it ran, in nanoseconds
+    template <Day D>
+    std::string cold_report(const SessionResult<D>& result)
+    {
+        auto [_, load, parse, solve] = session_phases(result);
+
+        auto ns = [](Timer::Duration dur) { return std::chrono::nanoseconds{ dur }.count(); };
+        return fmt::format("cold {} {} {}\n", ns(load), ns(parse), ns(solve));
+    }
+
+    inline std::optional<ColdRun> parse_cold_report(std::string_view output)
+    {
+        auto load = 0ll, parse = 0ll, solve = 0ll;
+        if (std::sscanf(std::string{ output }.c_str(), "cold %lld %lld %lld", &load, &parse, &solve) != 3) {
+            return std::nullopt;
         }
 
-        return { .m_parse_time = parse_time / repeat, .m_solve_time = solve_time / repeat };
+        return ColdRun{
+            .m_process = {},
+            .m_load    = std::chrono::nanoseconds{ load },
+            .m_parse   = std::chrono::nanoseconds{ parse },
+            .m_solve   = std::chrono::nanoseconds{ solve },
+        };
+    }
+
+    // every run is a new process started from `exe` with `args`, which is expected to run the session of D on
+    // `infile` and print its cold_report; the process time covers everything from the spawn to the exit
+    // (dynamic loading, static initialization, argument parsing, ...). after that the same session runs a few
+    // times in this process for the hot numbers. throws if a run fails
+    template <Day D>
+    ColdResult cold_solution(
+        const D&                     day,
+        const fs::path&              infile,
+        const ColdConfig&            config,
+        const fs::path&              exe,
+        std::span<const std::string> args,
+        const SolveConfig&           solve_config = {}
+    )
+    {
+        if (config.m_runs < 2) {
+            throw std::logic_error{ "a cold measurement needs at least 2 runs, the first and a steady one" };
+        }
+
+        auto runs = std::vector<ColdRun>{};
+        for (auto i = 0uz; i < config.m_runs; ++i) {
+            if (config.m_evict) {
+                util::evict_page_cache(infile);
+                util::evict_page_cache(snapshot_path(infile));
+                util::flush_cpu_caches();
+            }
+
+            auto timer   = Timer{};
+            auto process = util::run_process(exe, args);
+            auto elapsed = timer.elapsed();
+
+            auto run = parse_cold_report(process.m_output);
+            if (process.m_exit_code != 0 or not run.has_value()) {
+                auto what = fmt::format("cold run {} failed (exit code {})", i, process.m_exit_code);
+                throw std::runtime_error{ what };
+            }
+
+            run->m_process = elapsed;
+            runs.push_back(*run);
+        }
+
+        auto steady = std::span{ runs }.subspan(1);
+        auto median = [&](Timer::Duration ColdRun::* phase) {
+            auto values = std::vector<double>{};
+            for (const auto& run : steady) {
+                values.push_back(static_cast<double>((run.*phase).count()));
+            }
+            return Timer::Duration{ static_cast<Timer::Duration::rep>(std::llround(util::median_of(values))) };
+        };
+
+        auto processes = std::vector<Timer::Duration>{};
+        for (const auto& run : steady) {
+            processes.push_back(run.m_process);
+        }
+
+        constexpr auto warmup = 3uz;
+
+        for (auto i = 0uz; i < warmup; ++i) {
+            std::ignore = run_session(day, infile, solve_config);
+        }
+        auto hot = session_phases(run_session(day, infile, solve_config));
+
+        return {
+            .m_first   = runs.front(),
+            .m_steady  = {
+                .m_process = median(&ColdRun::m_process),
+                .m_load    = median(&ColdRun::m_load),
+                .m_parse   = median(&ColdRun::m_parse),
+                .m_solve   = median(&ColdRun::m_solve),
+            },
+            .m_hot     = hot,
+            .m_process = util::compute_stats<Timer::Duration>(processes),
+        };
     }
 
     template <Displayable T>
@@ -1,11 +1,13 @@
 #pragma once
 
 #include "aliases.hpp"
+#include "util/snapshot.hpp"
 
 #include <fmt/base.h>
 
 #include <concepts>
 #include <ranges>
+#include <utility>
 
 namespace aoc::concepts
 {
@@ -45,13 +47,81 @@ namespace aoc::concepts
         { T::id } -> std::convertible_to<std::string_view>;
         { T::name } -> std::convertible_to<std::string_view>;
 
+        // the input may be taken by value, by const reference or by rvalue reference (see BorrowingPartOne)
         requires requires (const T ct, T::Input input, aliases::Lines lines, aliases::Context ctx) {
             { ct.parse(lines, ctx) } -> std::same_as<typename T::Input>;
-            { ct.solve_part_one(input, ctx) } -> std::same_as<typename T::Output>;
-            { ct.solve_part_two(input, ctx) } -> std::same_as<typename T::Output>;
+            { ct.solve_part_one(std::move(input), ctx) } -> std::same_as<typename T::Output>;
+            { ct.solve_part_two(std::move(input), ctx) } -> std::same_as<typename T::Output>;
         };
     };
 
+    namespace detail
+    {
+        template <typename T>
+        using BorrowingSolve = typename T::Output (T::*)(const typename T::Input&, aliases::Context) const;
+    }
+
+    // a part that only reads its input takes it by const reference, the harness then lends it the input instead
+    // of handing over a copy; a part that mutates its input takes it by rvalue reference instead, stating that
+    // it consumes it (by value still works, the harness treats it the same as by rvalue reference)
+    template <typename T>
+    concept BorrowingPartOne = Day<T> and std::same_as<decltype(&T::solve_part_one), detail::BorrowingSolve<T>>;
+
+    template <typename T>
+    concept BorrowingPartTwo = Day<T> and std::same_as<decltype(&T::solve_part_two), detail::BorrowingSolve<T>>;
+
+    // the parsed input can be written to a snapshot and read back from it later instead of parsing the text again
+    // (see common::open_snapshot); snapshot_version is to be bumped whenever what save_snapshot writes changes
+    template <typename T>
+    concept Snapshotable = Day<T> and requires (
+        const T                ct,
+        const T::Input         input,
+        util::SnapshotWriter&  writer,
+        util::SnapshotReader&  reader,
+        aliases::Context       ctx
+    ) {
+        { T::snapshot_version } -> std::convertible_to<std::uint32_t>;
+        ct.save_snapshot(input, writer);
+        { ct.load_snapshot(reader, ctx) } -> std::same_as<typename T::Input>;
+    };
+
+    // consumes the input one line at a time, keeping only the state it needs, then produces the result
+    template <typename S, typename Output>
+    concept LineSink = requires (S sink, std::string_view line) {
+        requires std::movable<S>;
+
+        sink.feed(line);
+        { std::move(sink).finish() } -> std::same_as<Output>;
+    };
+
+    // optional interface for days whose part can be solved without the whole input being in memory, picked
+    // automatically by common::run_solution when available
+    template <typename T>
+    concept StreamingPartOne = Day<T> and requires (const T ct, aliases::Context ctx) {
+        { ct.stream_part_one(ctx) } -> LineSink<typename T::Output>;
+    };
+
+    template <typename T>
+    concept StreamingPartTwo = Day<T> and requires (const T ct, aliases::Context ctx) {
+        { ct.stream_part_two(ctx) } -> LineSink<typename T::Output>;
+    };
+
+    // optional interface for days whose parts share intermediate work (memo tables, search trees, ...), preferred
+    // by common::run_session over solving the parts one by one
+    template <typename T>
+    concept SolveBoth = Day<T> and requires (const T ct, T::Input input, aliases::Context ctx) {
+        {
+            ct.solve_both(std::move(input), ctx)
+        } -> std::same_as<std::pair<typename T::Output, typename T::Output>>;
+    };
+
+    // the input can be cut down to a fraction of its size and still be a valid input (see common::truncate_input),
+    // which lets the harness run the day at a series of sizes and fit its scaling
+    template <typename T>
+    concept Sweepable = Day<T> and requires {
+        { T::input_shape } -> std::convertible_to<aliases::InputShape>;
+    };
+
     namespace detail
     {
         template <typename>
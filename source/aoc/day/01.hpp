@@ -14,8 +14,9 @@ namespace aoc::day
 
     struct Day01
     {
-        static constexpr auto id   = "01";
-        static constexpr auto name = "historian-hysteria";
+        static constexpr auto id          = "01";
+        static constexpr auto name        = "historian-hysteria";
+        static constexpr auto input_shape = common::InputShape::Lines;
 
         using Pair = std::pair<al::i32, al::i32>;
 
@@ -33,7 +34,7 @@ namespace aoc::day
         }
 
         // TODO: try using binary search tree
-        Output solve_part_one(Input input, common::Context /* ctx */) const
+        Output solve_part_one(const Input& input, common::Context /* ctx */) const
         {
             auto left  = std::vector<al::i32>{};
             auto right = std::vector<al::i32>{};
@@ -50,7 +51,7 @@ namespace aoc::day
             return sr::fold_left(sv::zip(left, right) | sv::transform(diff), 0, std::plus{});
         }
 
-        Output solve_part_two(Input input, common::Context /* ctx */) const
+        Output solve_part_two(const Input& input, common::Context /* ctx */) const
         {
             auto left      = std::vector<al::i32>{};
             auto right     = std::vector<al::i32>{};
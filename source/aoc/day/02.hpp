@@ -12,10 +12,11 @@ namespace aoc::day
 
     struct Day02
     {
-        static constexpr auto id       = "02";
-        static constexpr auto name     = "red-nosed-reports";
-        static constexpr auto max_size = 8uz;
-        static constexpr auto invalid  = std::numeric_limits<al::i32>::max();
+        static constexpr auto id          = "02";
+        static constexpr auto name        = "red-nosed-reports";
+        static constexpr auto input_shape = common::InputShape::Lines;
+        static constexpr auto max_size    = 8uz;
+        static constexpr auto invalid     = std::numeric_limits<al::i32>::max();
 
         using Arr = std::array<al::i32, max_size>;
 
@@ -29,100 +30,117 @@ namespace aoc::day
             Decreasing,
         };
 
-        Input parse(common::Lines lines, common::Context /* ctx */) const
+        // streaming: only the count of the safe reports is kept
+        template <bool (*IsSafe)(const Arr&)>
+        struct SafeCounter
         {
-            auto to_arr = [](std::string_view line) -> Arr {
-                auto res = util::split_part_parse_n<al::i32, max_size>(line, ' ', invalid).as_success();
-                return std::move(res).m_parsed;
-            };
+            void   feed(std::string_view line) { m_count += IsSafe(parse_line(line)); }
+            Output finish() const { return m_count; }
+
+            Output m_count = 0;
+        };
 
-            return lines | sv::transform(to_arr) | sr::to<std::vector>();
+        static Arr parse_line(std::string_view line)
+        {
+            auto res = util::split_part_parse_n<al::i32, max_size>(line, ' ', invalid).as_success();
+            return std::move(res).m_parsed;
         }
 
-        Output solve_part_one(Input input, common::Context /* ctx */) const
+        static bool is_safe(const Arr& arr)
         {
-            auto is_safe = [&](const Arr& arr) {
-                auto diff = std::array<al::i32, max_size - 1>{};
-
-                auto invalid_idx = max_size - 1;
-                for (auto i : sv::iota(0uz, max_size - 1)) {
-                    if (arr[i + 1] == invalid) {
-                        invalid_idx = i;
-                        break;
-                    }
-                    diff[i] = arr[i + 1] - arr[i];
+            auto diff = std::array<al::i32, max_size - 1>{};
+
+            auto invalid_idx = max_size - 1;
+            for (auto i : sv::iota(0uz, max_size - 1)) {
+                if (arr[i + 1] == invalid) {
+                    invalid_idx = i;
+                    break;
                 }
+                diff[i] = arr[i + 1] - arr[i];
+            }
 
-                auto level = Level::Start;
-                for (auto i : sv::iota(0uz, invalid_idx)) {
-                    auto d = diff[i];
-
-                    if (d >= 1 and d <= 3) {
-                        if (level == Level::Decreasing) {
-                            return false;
-                        }
-                        level = Level::Increasing;
-                    } else if (d >= -3 and d <= -1) {
-                        if (level == Level::Increasing) {
-                            return false;
-                        }
-                        level = Level::Decreasing;
-                    } else {
+            auto level = Level::Start;
+            for (auto i : sv::iota(0uz, invalid_idx)) {
+                auto d = diff[i];
+
+                if (d >= 1 and d <= 3) {
+                    if (level == Level::Decreasing) {
+                        return false;
+                    }
+                    level = Level::Increasing;
+                } else if (d >= -3 and d <= -1) {
+                    if (level == Level::Increasing) {
                         return false;
                     }
+                    level = Level::Decreasing;
+                } else {
+                    return false;
                 }
+            }
 
-                return true;
-            };
-
-            auto count = sr::count_if(input, is_safe);
-            return static_cast<Output>(count);
+            return true;
         }
 
-        Output solve_part_two(Input input, common::Context /* ctx */) const
+        static bool is_safe_tolerant(const Arr& arr)
         {
-            auto is_safe = [&](const Arr& arr) {
-                auto diff = std::array<al::i32, max_size - 1>{};
-
-                auto invalid_idx = max_size - 1;
-                for (auto i : sv::iota(0uz, max_size - 1)) {
-                    if (arr[i + 1] == invalid) {
-                        invalid_idx = i;
-                        break;
-                    }
-                    diff[i] = arr[i + 1] - arr[i];
+            auto diff = std::array<al::i32, max_size - 1>{};
+
+            auto invalid_idx = max_size - 1;
+            for (auto i : sv::iota(0uz, max_size - 1)) {
+                if (arr[i + 1] == invalid) {
+                    invalid_idx = i;
+                    break;
                 }
+                diff[i] = arr[i + 1] - arr[i];
+            }
+
+            auto level     = Level::Start;
+            auto tolerance = 1_i32;
+
+            for (auto i : sv::iota(0uz, invalid_idx)) {
+                auto d = diff[i];
 
-                auto level     = Level::Start;
-                auto tolerance = 1_i32;
-
-                for (auto i : sv::iota(0uz, invalid_idx)) {
-                    auto d = diff[i];
-
-                    if (d >= 1 and d <= 3) {
-                        if (level == Level::Decreasing and tolerance-- == 0) {
-                            return false;
-                        }
-                        level = Level::Increasing;
-                    } else if (d >= -3 and d <= -1) {
-                        if (level == Level::Increasing and tolerance-- == 0) {
-                            return false;
-                        }
-                        level = Level::Decreasing;
-                    } else {
-                        if (tolerance-- == 0) {
-                            return false;
-                        }
+                if (d >= 1 and d <= 3) {
+                    if (level == Level::Decreasing and tolerance-- == 0) {
+                        return false;
+                    }
+                    level = Level::Increasing;
+                } else if (d >= -3 and d <= -1) {
+                    if (level == Level::Increasing and tolerance-- == 0) {
+                        return false;
+                    }
+                    level = Level::Decreasing;
+                } else {
+                    if (tolerance-- == 0) {
+                        return false;
                     }
                 }
+            }
+
+            return true;
+        }
 
-                return true;
-            };
+        Input parse(common::Lines lines, common::Context /* ctx */) const
+        {
+            return lines | sv::transform(parse_line) | sr::to<std::vector>();
+        }
 
+        Output solve_part_one(const Input& input, common::Context /* ctx */) const
+        {
             auto count = sr::count_if(input, is_safe);
             return static_cast<Output>(count);
         }
+
+        Output solve_part_two(const Input& input, common::Context /* ctx */) const
+        {
+            auto count = sr::count_if(input, is_safe_tolerant);
+            return static_cast<Output>(count);
+        }
+
+        SafeCounter<is_safe> stream_part_one(common::Context /* ctx */) const { return {}; }
+        SafeCounter<is_safe_tolerant> stream_part_two(common::Context /* ctx */) const { return {}; }
     };
 
     static_assert(common::Day<Day02>);
+    static_assert(common::StreamingPartOne<Day02> and common::StreamingPartTwo<Day02>);
 }
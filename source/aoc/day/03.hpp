@@ -150,12 +150,35 @@ namespace aoc::day
 
     struct Day03
     {
-        static constexpr auto id   = "03";
-        static constexpr auto name = "mull-it-over";
+        static constexpr auto id          = "03";
+        static constexpr auto name        = "mull-it-over";
+        static constexpr auto input_shape = common::InputShape::Lines;
 
         using Input  = common::Lines;
         using Output = al::i64;
 
+        // streaming: the lines are independent except for the do()/don't() state carried to the next line
+        struct MulSink
+        {
+            void feed(std::string_view line)
+            {
+                auto parser = day3::MulParser{ line };
+                if (m_conditional) {
+                    auto [res, enable]  = parser.parse_with_conditional(m_enabled);
+                    m_acc              += res;
+                    m_enabled           = enable;
+                } else {
+                    m_acc += parser.parse();
+                }
+            }
+
+            Output finish() const { return m_acc; }
+
+            bool   m_conditional;
+            bool   m_enabled = true;
+            Output m_acc     = 0;
+        };
+
         Input parse(common::Lines lines, common::Context /* ctx */) const { return lines; }
 
         Output solve_part_one(Input input, common::Context /* ctx */) const
@@ -184,7 +207,11 @@ namespace aoc::day
 
             return acc;
         }
+
+        MulSink stream_part_one(common::Context /* ctx */) const { return { .m_conditional = false }; }
+        MulSink stream_part_two(common::Context /* ctx */) const { return { .m_conditional = true }; }
     };
 
     static_assert(common::Day<Day03>);
+    static_assert(common::StreamingPartOne<Day03> and common::StreamingPartTwo<Day03>);
 }
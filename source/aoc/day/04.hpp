@@ -99,8 +99,9 @@ namespace aoc::day
 
     struct Day04
     {
-        static constexpr auto id   = "04";
-        static constexpr auto name = "ceres-search";
+        static constexpr auto id          = "04";
+        static constexpr auto name        = "ceres-search";
+        static constexpr auto input_shape = common::InputShape::Grid;
 
         using Input  = common::Lines;
         using Output = al::usize;
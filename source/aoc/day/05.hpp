@@ -4,6 +4,7 @@
 #include "common.hpp"
 #include "util.hpp"
 
+#include <memory_resource>
 #include <unordered_map>
 
 namespace aoc::day
@@ -14,13 +15,16 @@ namespace aoc::day
 
     struct Day05
     {
-        static constexpr auto id           = "05";
-        static constexpr auto name         = "print-queue";
-        static constexpr auto max_line_len = 23uz;    // the input of 05.txt says so
+        static constexpr auto id               = "05";
+        static constexpr auto name             = "print-queue";
+        static constexpr auto input_shape      = common::InputShape::Lines;
+        static constexpr auto max_line_len     = 23uz;    // the input of 05.txt says so
+        static constexpr auto snapshot_version = 1u;
 
-        using Rules   = std::unordered_map<al::u32, std::vector<al::u32>>;
-        using Pages   = std::vector<al::u32>;
-        using Updates = std::vector<Pages>;
+        // allocated from the memory resource of the context, the inner vectors too
+        using Rules   = std::pmr::unordered_map<al::u32, std::pmr::vector<al::u32>>;
+        using Pages   = std::pmr::vector<al::u32>;
+        using Updates = std::pmr::vector<Pages>;
 
         struct Input
         {
@@ -47,9 +51,9 @@ namespace aoc::day
             return correctly_ordered_last_index(rules, pages) == pages.size();
         }
 
-        Input parse(common::Lines lines, common::Context /* ctx */) const
+        Input parse(common::Lines lines, common::Context ctx) const
         {
-            auto parsed = Input{};
+            auto parsed = Input{ .m_rules = Rules{ ctx.memory() }, .m_updates = Updates{ ctx.memory() } };
 
             auto i = 0uz;
             while (i <= lines.size()) {
@@ -64,7 +68,7 @@ namespace aoc::day
 
             while (i < lines.size()) {
                 auto line       = lines[i++];
-                auto line_pages = std::vector<al::u32>{};
+                auto line_pages = Pages{ ctx.memory() };
                 line_pages.reserve(max_line_len);
 
                 auto splitter = util::StringSplitter{ line, ',' };
@@ -82,7 +86,43 @@ namespace aoc::day
             return parsed;
         }
 
-        Output solve_part_one(Input input, common::Context /* ctx */) const
+        void save_snapshot(const Input& input, util::SnapshotWriter& writer) const
+        {
+            writer.write(input.m_rules.size());
+            for (const auto& [page, after] : input.m_rules) {
+                writer.write(page);
+                writer.write_span(std::span{ after });
+            }
+
+            writer.write(input.m_updates.size());
+            for (const auto& pages : input.m_updates) {
+                writer.write_span(std::span{ pages });
+            }
+        }
+
+        Input load_snapshot(util::SnapshotReader& reader, common::Context ctx) const
+        {
+            auto loaded = Input{ .m_rules = Rules{ ctx.memory() }, .m_updates = Updates{ ctx.memory() } };
+
+            auto rule_count = reader.read<al::usize>();
+            loaded.m_rules.reserve(rule_count);
+            for (auto i = 0uz; i < rule_count; ++i) {
+                auto page  = reader.read<al::u32>();
+                auto after = reader.read_span<al::u32>();
+                loaded.m_rules.emplace(page, Pages{ after.begin(), after.end(), ctx.memory() });
+            }
+
+            auto update_count = reader.read<al::usize>();
+            loaded.m_updates.reserve(update_count);
+            for (auto i = 0uz; i < update_count; ++i) {
+                auto pages = reader.read_span<al::u32>();
+                loaded.m_updates.emplace_back(pages.begin(), pages.end(), ctx.memory());
+            }
+
+            return loaded;
+        }
+
+        Output solve_part_one(const Input& input, common::Context /* ctx */) const
         {
             const auto& [rules, updates] = input;
             auto acc_middle_num          = al::u32{ 0 };
@@ -98,11 +138,11 @@ namespace aoc::day
         }
 
         // TODO: use more efficient algorithm
-        Output solve_part_two(Input input, common::Context /* ctx */) const
+        Output solve_part_two(const Input& input, common::Context ctx) const
         {
             const auto& [rules, updates] = input;
 
-            auto ordered = std::vector<al::u32>{};
+            auto ordered = std::pmr::vector<al::u32>{ ctx.memory() };
             ordered.reserve(max_line_len);
 
             auto rectify_order = [&](std::span<const al::u32> pages, al::usize unorder_pos) {
@@ -150,4 +190,5 @@ namespace aoc::day
     };
 
     static_assert(common::Day<Day05>);
+    static_assert(common::Snapshotable<Day05>);
 }
@@ -3,6 +3,11 @@
 #include "aliases.hpp"
 #include "common.hpp"
 
+#include <atomic>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
 namespace aoc::day
 {
     namespace al = aoc::aliases;
@@ -29,6 +34,14 @@ namespace aoc::day
             auto operator<=>(const Position&) const = default;
         };
 
+        // a new obstruction and the state of the guard right before running into it
+        struct Candidate
+        {
+            Position m_obstruction;
+            Position m_pos;
+            Facing   m_facing;
+        };
+
         struct ScratchMap
         {
             ScratchMap(al::usize width, al::usize height, Facing facing)
@@ -102,6 +115,7 @@ namespace aoc::day
         using Facing     = day6::Facing;
         using ScratchMap = day6::ScratchMap;
         using Position   = day6::Position;
+        using Candidate  = day6::Candidate;
 
         Position find_guard(Input input) const
         {
@@ -243,10 +257,12 @@ namespace aoc::day
             return static_cast<Output>(count);
         }
 
-        Output solve_part_two(Input input, common::Context /* ctx */) const
+        Output solve_part_two(Input input, common::Context ctx) const { return solve_both(input, ctx).second; }
+
+        // the walk that finds the candidates of part two visits the same positions as part one
+        std::pair<Output, Output> solve_both(Input input, common::Context ctx) const
         {
-            auto scratchmap      = ScratchMap{ input[0].size(), input.size(), Facing::Invalid };
-            auto scratchmap_copy = scratchmap;
+            auto scratchmap = ScratchMap{ input[0].size(), input.size(), Facing::Invalid };
 
             const auto initial_pos     = find_guard(input);
             const auto has_obstruction = [&](Position p) { return input[p.m_y][p.m_x] == obstruction; };
@@ -254,7 +270,7 @@ namespace aoc::day
             auto facing = Facing::Up;
             auto pos    = initial_pos;
 
-            auto looping_count = 0uz;
+            auto candidates = std::pmr::vector<Candidate>{ ctx.memory() };
 
             while (pos.m_y < input.size() and pos.m_x < input[0].size()) {
                 auto next = guard_next_step(input, pos, facing, has_obstruction);
@@ -270,18 +286,36 @@ namespace aoc::day
                 // since if there is an obstruction there, we can't arrive at current position
                 // - we can't place obstruction at the initial position
                 if (scratchmap[new_pos] == Facing::Invalid and new_pos != initial_pos) {
-                    scratchmap_copy  = scratchmap;
-                    auto looping     = guard_is_looping(input, scratchmap_copy, new_pos, pos, facing);
-                    looping_count   += looping;
+                    candidates.push_back({ .m_obstruction = new_pos, .m_pos = pos, .m_facing = facing });
                 }
 
                 pos    = new_pos;
                 facing = new_facing;
             }
 
-            return looping_count;
+            auto visited = sr::count_if(scratchmap.m_facing, [](auto f) { return f != Facing::Invalid; });
+
+            // the path up to a candidate is the same with or without the new obstruction, so it's enough to start
+            // from right before it with an empty scratch map; this makes the candidates independent of each other
+            auto looping_count = std::atomic<al::usize>{ 0 };
+
+            ctx.parallel_for(candidates.size(), [&](al::usize begin, al::usize end) {
+                auto scratch = ScratchMap{ input[0].size(), input.size(), Facing::Invalid };
+                auto chunk   = std::span{ candidates }.subspan(begin, end - begin);
+                auto count   = 0uz;
+
+                for (const auto& [obstruction_pos, start_pos, start_facing] : chunk) {
+                    scratch.fill(Facing::Invalid);
+                    count += guard_is_looping(input, scratch, obstruction_pos, start_pos, start_facing);
+                }
+
+                looping_count += count;
+            });
+
+            return { static_cast<Output>(visited), looping_count };
         }
     };
 
     static_assert(common::Day<Day06>);
+    static_assert(common::SolveBoth<Day06>);
 }
@@ -11,8 +11,9 @@ namespace aoc::day
 
     struct Day07
     {
-        static constexpr auto id   = "07";
-        static constexpr auto name = "bridge-repair";
+        static constexpr auto id          = "07";
+        static constexpr auto name        = "bridge-repair";
+        static constexpr auto input_shape = common::InputShape::Lines;
 
         static constexpr auto max_operands  = 12uz;
         static constexpr auto invalid_value = std::numeric_limits<al::u64>::max();
@@ -147,34 +148,57 @@ namespace aoc::day
         using Input  = std::vector<Equation>;
         using Output = al::u64;
 
-        Input parse(common::Lines lines, common::Context /* ctx */) const
+        // streaming: every equation is checked as soon as its line is read
+        template <typename Perm>
+        struct CalibrationSink
         {
-            auto input = Input{};
-
-            for (auto line : lines) {
-                auto res = util::split_n<2>(line, ':');
-                if (not res) {
-                    throw std::runtime_error{ "Failed to parse input" };
+            void feed(std::string_view line)
+            {
+                auto [expect, ops] = parse_equation(line);
+                if (m_perm_op.can_produce_result(ops.get(), expect)) {
+                    m_result += expect;
                 }
-                auto [expect_str, operands_str] = *res;
+                m_perm_op.reset();
+            }
 
-                auto [expect, ec] = util::from_chars<al::u64>(expect_str);
-                if (ec != std::errc{}) {
-                    auto err_code = std::make_error_code(ec);
-                    throw std::runtime_error{ err_code.message() };
-                }
+            Output finish() const { return m_result; }
+
+            Perm   m_perm_op = {};
+            Output m_result  = 0;
+        };
+
+        static Equation parse_equation(std::string_view line)
+        {
+            auto res = util::split_n<2>(line, ':');
+            if (not res) {
+                throw std::runtime_error{ "Failed to parse input" };
+            }
+            auto [expect_str, operands_str] = *res;
+
+            auto [expect, ec] = util::from_chars<al::u64>(expect_str);
+            if (ec != std::errc{}) {
+                auto err_code = std::make_error_code(ec);
+                throw std::runtime_error{ err_code.message() };
+            }
 
-                auto ops = util::split_part_parse_n<al::u64, max_operands>(operands_str, ' ', invalid_value);
-                auto [parsed, count] = std::move(ops).as_success();
+            auto ops = util::split_part_parse_n<al::u64, max_operands>(operands_str, ' ', invalid_value);
+            auto [parsed, count] = std::move(ops).as_success();
 
-                auto operands = Operands{ .m_values = std::move(parsed), .m_count = count };
-                input.emplace_back(expect, operands);
+            return { expect, Operands{ .m_values = std::move(parsed), .m_count = count } };
+        }
+
+        Input parse(common::Lines lines, common::Context /* ctx */) const
+        {
+            auto input = Input{};
+
+            for (auto line : lines) {
+                input.push_back(parse_equation(line));
             }
 
             return input;
         }
 
-        Output solve_part_one(Input input, common::Context /* ctx */) const
+        Output solve_part_one(const Input& input, common::Context /* ctx */) const
         {
             auto result  = 0uz;
             auto perm_op = PermutatedOperation{};
@@ -189,7 +213,7 @@ namespace aoc::day
             return result;
         }
 
-        Output solve_part_two(Input input, common::Context /* ctx */) const
+        Output solve_part_two(const Input& input, common::Context /* ctx */) const
         {
             auto result  = 0uz;
             auto perm_op = PermutatedOperation3{};
@@ -207,7 +231,11 @@ namespace aoc::day
 
             return result;
         }
+
+        CalibrationSink<PermutatedOperation> stream_part_one(common::Context /* ctx */) const { return {}; }
+        CalibrationSink<PermutatedOperation3> stream_part_two(common::Context /* ctx */) const { return {}; }
     };
 
     static_assert(common::Day<Day07>);
+    static_assert(common::StreamingPartOne<Day07> and common::StreamingPartTwo<Day07>);
 }
@@ -92,9 +92,10 @@ namespace aoc::day
 
     struct Day08
     {
-        static constexpr auto id         = "08";
-        static constexpr auto name       = "resonant-collineariry";
-        static constexpr auto no_antenna = '.';
+        static constexpr auto id          = "08";
+        static constexpr auto name        = "resonant-collineariry";
+        static constexpr auto input_shape = common::InputShape::Grid;
+        static constexpr auto no_antenna  = '.';
 
         using Antenna          = day8::Antenna;
         using Coordinate       = day8::Coordinate<>;
@@ -125,7 +126,7 @@ namespace aoc::day
             return antenna_map;
         }
 
-        Output solve_part_one(Input input, common::Context /* ctx */) const
+        Output solve_part_one(const Input& input, common::Context /* ctx */) const
         {
             const auto& [antennas, width, height] = input;
             auto antinodes                        = CoordinateVector{};
@@ -156,7 +157,7 @@ namespace aoc::day
             return unique_count;
         }
 
-        Output solve_part_two(Input input, common::Context /* ctx */) const
+        Output solve_part_two(const Input& input, common::Context /* ctx */) const
         {
             const auto& [antennas, width, height] = input;
 
@@ -32,6 +32,10 @@ namespace aoc::day
         static constexpr auto name  = "disk-fragmenter";
         static constexpr auto empty = std::numeric_limits<al::usize>::max();
 
+        // the disk map is a single line, which InputShape::Lines can't cut any shorter; as a grid of one row
+        // truncate_input cuts the line itself, each digit being a cell
+        static constexpr auto input_shape = common::InputShape::Grid;
+
         using Input  = std::string_view;
         using Output = al::usize;
 
@@ -25,7 +25,7 @@ namespace aoc::day
                 return std::forward<decltype(self)>(self).m_map[y][x];
             }
 
-            auto surrounding_four(const Coord& coord)
+            auto surrounding_four(const Coord& coord) const
             {
                 using Diff    = util::Coordinate<std::make_signed_t<Coord::Type>>;
                 using DiffArr = std::array<Diff, 4>;
@@ -43,10 +43,11 @@ namespace aoc::day
 
     struct Day10
     {
-        static constexpr auto id        = "10";
-        static constexpr auto name      = "hoof-it";
-        static constexpr auto trailhead = '0';
-        static constexpr auto peak      = '9';
+        static constexpr auto id          = "10";
+        static constexpr auto name        = "hoof-it";
+        static constexpr auto input_shape = common::InputShape::Grid;
+        static constexpr auto trailhead   = '0';
+        static constexpr auto peak        = '9';
 
         using Coord          = day10::Coord;
         using TopographicMap = day10::TopographicMap;
@@ -69,7 +70,7 @@ namespace aoc::day
             return { TopographicMap{ lines }, trail_heads };
         }
 
-        Output solve_part_one(Input input, common::Context /* ctx */) const
+        Output solve_part_one(const Input& input, common::Context /* ctx */) const
         {
             auto&& [map, heads] = input;
 
@@ -94,7 +95,7 @@ namespace aoc::day
             return sr::fold_left(heads, 0uz, acc);
         }
 
-        Output solve_part_two(Input input, common::Context /* ctx */) const
+        Output solve_part_two(const Input& input, common::Context /* ctx */) const
         {
             auto&& [map, heads] = input;
 
@@ -61,41 +61,59 @@ namespace aoc::day
             return input;
         }
 
-        Output solve_impl(Input input, al::usize blinks) const
-        {
-            // x = blink, y = num
-            using MemoEntry = util::Coordinate<al::u64>;
-            auto memo       = std::unordered_map<MemoEntry, al::usize>{};
+        // x = blinks left, y = num; independent of the total number of blinks so it can be shared between parts
+        using Memo = std::unordered_map<util::Coordinate<al::u64>, al::usize>;
 
-            auto blink = [&](this auto&& self, al::usize current_blink, al::u64 num) -> al::usize {
-                if (current_blink >= blinks) {
+        Output solve_impl(const Input& input, al::usize blinks, Memo& memo) const
+        {
+            auto blink = [&](this auto&& self, al::usize blinks_left, al::u64 num) -> al::usize {
+                if (blinks_left == 0) {
                     return 1;
                 }
 
-                if (auto it = memo.find({ current_blink, num }); it != memo.end()) {
+                if (auto it = memo.find({ blinks_left, num }); it != memo.end()) {
                     return it->second;
                 }
 
                 auto result = 0uz;
                 if (num == 0) {
-                    result = self(current_blink + 1, 1);
+                    result = self(blinks_left - 1, 1);
                 } else if (auto digits = day11::num_digits(num); digits % 2 == 0) {
                     auto [left, right] = day11::split_digits(num, digits / 2);
-                    result             = self(current_blink + 1, left) + self(current_blink + 1, right);
+                    result             = self(blinks_left - 1, left) + self(blinks_left - 1, right);
                 } else {
-                    result = self(current_blink + 1, num * 2024);
+                    result = self(blinks_left - 1, num * 2024);
                 }
 
-                memo[{ current_blink, num }] = result;
+                memo[{ blinks_left, num }] = result;
                 return result;
             };
 
-            return sr::fold_left(input, 0uz, [&](al::usize a, al::u64 n) { return a + blink(0uz, n); });
+            return sr::fold_left(input, 0uz, [&](al::usize a, al::u64 n) { return a + blink(blinks, n); });
+        }
+
+        Output solve_part_one(const Input& input, common::Context /* ctx */) const
+        {
+            auto memo = Memo{};
+            return solve_impl(input, num_blinks_part_one, memo);
+        }
+
+        Output solve_part_two(const Input& input, common::Context /* ctx */) const
+        {
+            auto memo = Memo{};
+            return solve_impl(input, num_blinks_part_two, memo);
         }
 
-        Output solve_part_one(Input input, common::Context /* ctx */) const { return solve_impl(std::move(input), num_blinks_part_one); }
-        Output solve_part_two(Input input, common::Context /* ctx */) const { return solve_impl(std::move(input), num_blinks_part_two); }
+        // part two finds every count of part one already in the memo
+        std::pair<Output, Output> solve_both(const Input& input, common::Context /* ctx */) const
+        {
+            auto memo = Memo{};
+            auto one  = solve_impl(input, num_blinks_part_one, memo);
+            auto two  = solve_impl(input, num_blinks_part_two, memo);
+            return { one, two };
+        }
     };
 
     static_assert(common::Day<Day11>);
+    static_assert(common::SolveBoth<Day11>);
 }
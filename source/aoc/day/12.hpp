@@ -5,6 +5,7 @@
 #include "util.hpp"
 
 #include <deque>
+#include <memory_resource>
 #include <unordered_set>
 #include <vector>
 
@@ -33,17 +34,17 @@ namespace aoc::day
 
         struct Region2
         {
-            char                      m_name;
-            al::usize                 m_corners;
-            std::unordered_set<Coord> m_area;
+            char                           m_name;
+            al::usize                      m_corners;
+            std::pmr::unordered_set<Coord> m_area;
         };
 
         struct Visited
         {
-            Visited(al::usize width, al::usize height)
+            Visited(al::usize width, al::usize height, std::pmr::memory_resource* memory)
                 : m_width(width)
                 , m_height(height)
-                , m_visited(width * height, 0x00)
+                , m_visited(width * height, 0x00, memory)
             {
             }
 
@@ -59,16 +60,17 @@ namespace aoc::day
                 m_visited[y * m_width + x] = true;
             }
 
-            al::usize         m_width;
-            al::usize         m_height;
-            std::vector<bool> m_visited;
+            al::usize              m_width;
+            al::usize              m_height;
+            std::pmr::vector<bool> m_visited;
         };
     }
 
     struct Day12
     {
-        static constexpr auto id   = "12";
-        static constexpr auto name = "garden-groups";
+        static constexpr auto id          = "12";
+        static constexpr auto name        = "garden-groups";
+        static constexpr auto input_shape = common::InputShape::Grid;
 
         using Coord   = day12::Coord;
         using Visited = day12::Visited;
@@ -91,19 +93,23 @@ namespace aoc::day
             return { width, lines.size(), lines };
         }
 
-        Output solve_part_one(Input input, common::Context /* ctx */) const
+        Output solve_part_one(Input input, common::Context ctx) const
         {
             auto&& [width, height, map] = input;
 
             const auto min = Coord{ 0, 0 };
             const auto max = Coord{ width, height };
 
-            auto visited = Visited{ input.m_width, input.m_height };
-            auto queue   = std::deque<Coord>{};
+            // the queue keeps dropping and taking blocks, the pool recycles them since the arena never frees
+            auto pool = std::pmr::unsynchronized_pool_resource{ ctx.memory() };
+
+            auto visited = Visited{ input.m_width, input.m_height, ctx.memory() };
+            auto queue   = std::pmr::deque<Coord>{ &pool };
 
             auto find_region = [&](const Coord& coord, char name) -> Region {
+                AOC_TRACE_SCOPE("region bfs");
+
                 auto region = Region{ name, 0uz, 0uz };
-                auto outers = std::unordered_set<Coord>{};
 
                 queue.push_back(coord);
 
@@ -140,19 +146,24 @@ namespace aoc::day
             return price;
         }
 
-        Output solve_part_two(Input input, common::Context /* ctx */) const
+        Output solve_part_two(Input input, common::Context ctx) const
         {
             auto&& [width, height, map] = input;
 
             const auto min = Coord{ 0, 0 };
             const auto max = Coord{ width, height };
 
-            auto visited = Visited{ input.m_width, input.m_height };
-            auto queue   = std::deque<Coord>{};
+            // same as above, the sets are also made and dropped once per region
+            auto pool = std::pmr::unsynchronized_pool_resource{ ctx.memory() };
+
+            auto visited = Visited{ input.m_width, input.m_height, ctx.memory() };
+            auto queue   = std::pmr::deque<Coord>{ &pool };
 
             auto find_region = [&](const Coord& coord, char name) -> Region2 {
-                auto region = Region2{ name, 0uz, {} };
-                auto outers = std::unordered_set<Coord>{};
+                AOC_TRACE_SCOPE("region bfs");
+
+                auto region = Region2{ name, 0uz, std::pmr::unordered_set<Coord>{ &pool } };
+                auto outers = std::pmr::unordered_set<Coord>{ &pool };
 
                 queue.push_back(coord);
 
@@ -24,8 +24,9 @@ namespace aoc::day
 
     struct Day13
     {
-        static constexpr auto id   = "13";
-        static constexpr auto name = "claw-contraption";
+        static constexpr auto id               = "13";
+        static constexpr auto name             = "claw-contraption";
+        static constexpr auto snapshot_version = 1u;
 
         using Coord   = day13::Coord;
         using Machine = day13::Machine;
@@ -33,28 +34,84 @@ namespace aoc::day
         using Input  = std::vector<Machine>;
         using Output = al::i64;
 
-        Input parse(common::Lines lines, common::Context /* ctx */) const
+        static constexpr auto cost = Coord{ 3, 1 };
+
+        // streaming: a machine is solved as soon as its three lines are read, blank lines are skipped
+        struct MachineSink
+        {
+            void feed(std::string_view line)
+            {
+                if (line.empty()) {
+                    return;
+                }
+
+                switch (m_line++) {
+                case 0: m_machine.m_button_a = parse_btn(line); return;
+                case 1: m_machine.m_button_b = parse_btn(line); return;
+                default: m_machine.m_prize = parse_prize(line); break;
+                }
+
+                auto [na, nb]  = solve_machine(m_machine, m_prize_offset);
+                m_sum         += cost.m_x * na + cost.m_y * nb;
+                m_line         = 0;
+            }
+
+            Output finish() const
+            {
+                ASSERT(m_line == 0, "incomplete machine at the end of the input");
+                return m_sum;
+            }
+
+            al::i64 m_prize_offset;
+            Machine m_machine = {};
+            int     m_line    = 0;
+            Output  m_sum     = 0;
+        };
+
+        static Coord parse_btn(std::string_view line)
+        {
+            auto delims                   = util::SplitDelim{ " :,+" };
+            auto [btn, n, x, x_v, y, y_v] = util::split_n<6>(line, delims).value();
+
+            auto x_val = util::from_chars<al::i64>(x_v).first;
+            auto y_val = util::from_chars<al::i64>(y_v).first;
+
+            return { x_val, y_val };
+        }
+
+        static Coord parse_prize(std::string_view line)
         {
-            auto parse_btn = [](std::string_view line) -> Coord {
-                auto delims                   = util::SplitDelim{ " :,+" };
-                auto [btn, n, x, x_v, y, y_v] = util::split_n<6>(line, delims).value();
+            auto delims                  = util::SplitDelim{ " :,=" };
+            auto [prize, x, x_v, y, y_v] = util::split_n<5>(line, delims).value();
 
-                auto x_val = util::from_chars<al::i64>(x_v).first;
-                auto y_val = util::from_chars<al::i64>(y_v).first;
+            auto x_val = util::from_chars<al::i64>(x_v).first;
+            auto y_val = util::from_chars<al::i64>(y_v).first;
 
-                return { x_val, y_val };
-            };
+            return { x_val, y_val };
+        }
 
-            auto parse_prize = [](std::string_view line) -> Coord {
-                auto delims                  = util::SplitDelim{ " :,=" };
-                auto [prize, x, x_v, y, y_v] = util::split_n<5>(line, delims).value();
+        // number of presses of button a and b, zero if the prize can't be reached
+        static Coord solve_machine(const Machine& machine, al::i64 prize_offset)
+        {
+            auto [btn_a, btn_b, prize] = machine;
 
-                auto x_val = util::from_chars<al::i64>(x_v).first;
-                auto y_val = util::from_chars<al::i64>(y_v).first;
+            auto [ax, ay] = btn_a;
+            auto [bx, by] = btn_b;
+            auto [px, py] = prize + prize_offset;
 
-                return { x_val, y_val };
-            };
+            auto det   = (ax * by) - (ay * bx);
+            auto det_a = (px * by) - (py * bx);
+            auto det_b = (ax * py) - (ay * px);
 
+            if (det_a % det == 0 and det_b % det == 0) {
+                return { det_a / det, det_b / det };
+            }
+
+            return { 0, 0 };
+        }
+
+        Input parse(common::Lines lines, common::Context /* ctx */) const
+        {
             return lines           //
                  | sv::chunk(4)    //
                  | sv::transform([&](auto group) -> Machine {
@@ -64,37 +121,33 @@ namespace aoc::day
                  | sr::to<std::vector>();
         }
 
-        Output solve_impl(Input input, al::i64 prize_offset) const
+        void save_snapshot(const Input& input, util::SnapshotWriter& writer) const
         {
-            auto solve = [&](const Machine& machine) -> Coord {
-                auto [btn_a, btn_b, prize] = machine;
-
-                auto [ax, ay] = btn_a;
-                auto [bx, by] = btn_b;
-                auto [px, py] = prize + prize_offset;
-
-                auto det   = (ax * by) - (ay * bx);
-                auto det_a = (px * by) - (py * bx);
-                auto det_b = (ax * py) - (ay * px);
-
-                if (det_a % det == 0 and det_b % det == 0) {
-                    return { det_a / det, det_b / det };
-                }
-
-                return { 0, 0 };
-            };
+            writer.write_span(std::span{ input });
+        }
 
-            constexpr auto cost = Coord{ 3, 1 };
+        Input load_snapshot(util::SnapshotReader& reader, common::Context /* ctx */) const
+        {
+            auto machines = reader.read_span<Machine>();
+            return { machines.begin(), machines.end() };
+        }
 
+        Output solve_impl(const Input& input, al::i64 prize_offset) const
+        {
             return sr::fold_left(input, 0_i64, [&](auto&& sum, auto&& machine) {
-                auto [na, nb] = solve(machine);
+                auto [na, nb] = solve_machine(machine, prize_offset);
                 return sum + cost.m_x * na + cost.m_y * nb;
             });
         }
 
-        Output solve_part_one(Input input, common::Context /* ctx */) const { return solve_impl(input, 0); }
-        Output solve_part_two(Input input, common::Context /* ctx */) const { return solve_impl(input, 10'000'000'000'000); }
+        Output solve_part_one(const Input& input, common::Context /* ctx */) const { return solve_impl(input, 0); }
+        Output solve_part_two(const Input& input, common::Context /* ctx */) const { return solve_impl(input, 10'000'000'000'000); }
+
+        MachineSink stream_part_one(common::Context /* ctx */) const { return { .m_prize_offset = 0 }; }
+        MachineSink stream_part_two(common::Context /* ctx */) const { return { .m_prize_offset = 10'000'000'000'000 }; }
     };
 
     static_assert(common::Day<Day13>);
+    static_assert(common::StreamingPartOne<Day13> and common::StreamingPartTwo<Day13>);
+    static_assert(common::Snapshotable<Day13>);
 }
@@ -135,22 +135,27 @@ namespace aoc::day
         using Input  = std::vector<Robot>;
         using Output = al::usize;
 
-        Input parse(common::Lines lines, common::Context /* ctx */) const
+        // streaming (part one only, part two needs every robot at once): robots are counted as they are read
+        struct QuadrantSink
         {
-            auto parse = [](std::string_view str) -> Robot {
-                auto [p, px, py, v, vx, vy] = util::split_n<6>(str, util::SplitDelim{ " =," }).value();
-                auto to_i64                 = [](auto sv) { return util::from_chars<al::i64>(sv).first; };
-
-                return {
-                    .m_pos = { to_i64(px), to_i64(py) },
-                    .m_vel = { to_i64(vx), to_i64(vy) },
-                };
-            };
+            void   feed(std::string_view line) { add_to_quadrant(m_quadrant, parse_robot(line)); }
+            Output finish() const { return sr::fold_left(m_quadrant, 1uz, std::multiplies{}); }
+
+            std::array<al::usize, 4> m_quadrant = {};
+        };
+
+        static Robot parse_robot(std::string_view str)
+        {
+            auto [p, px, py, v, vx, vy] = util::split_n<6>(str, util::SplitDelim{ " =," }).value();
+            auto to_i64                 = [](auto sv) { return util::from_chars<al::i64>(sv).first; };
 
-            return lines | sv::transform(parse) | sr::to<std::vector>();
+            return {
+                .m_pos = { to_i64(px), to_i64(py) },
+                .m_vel = { to_i64(vx), to_i64(vy) },
+            };
         }
 
-        Output solve_part_one(Input input, common::Context /* ctx */) const
+        static void add_to_quadrant(std::array<al::usize, 4>& quadrant, const Robot& robot)
         {
             //    --> x+
             //  |
@@ -158,31 +163,43 @@ namespace aoc::day
             //  y+  ---------
             //      III |  IV
 
-            auto quadrant = std::array{ 0uz, 0uz, 0uz, 0uz };
-
             const auto [w, h] = map_size;
 
+            auto next_pos       = robot.m_pos + robot.m_vel * timestep;
+            auto [x, y]         = day14::mod(next_pos, map_size);
+            auto [x_mid, y_mid] = std::pair{ w / 2, h / 2 };
+
+            if (x < x_mid and y < y_mid) {
+                ++quadrant[0];
+            } else if (x > x_mid and y < y_mid) {
+                ++quadrant[1];
+            } else if (x < x_mid and y > y_mid) {
+                ++quadrant[2];
+            } else if (x > x_mid and y > y_mid) {
+                ++quadrant[3];
+            }
+        }
+
+        Input parse(common::Lines lines, common::Context /* ctx */) const
+        {
+            return lines | sv::transform(parse_robot) | sr::to<std::vector>();
+        }
+
+        Output solve_part_one(const Input& input, common::Context /* ctx */) const
+        {
+            auto quadrant = std::array{ 0uz, 0uz, 0uz, 0uz };
+
             for (auto&& robot : input) {
-                auto next_pos       = robot.m_pos + robot.m_vel * timestep;
-                auto [x, y]         = day14::mod(next_pos, map_size);
-                auto [x_mid, y_mid] = std::pair{ w / 2, h / 2 };
-
-                if (x < x_mid and y < y_mid) {
-                    ++quadrant[0];
-                } else if (x > x_mid and y < y_mid) {
-                    ++quadrant[1];
-                } else if (x < x_mid and y > y_mid) {
-                    ++quadrant[2];
-                } else if (x > x_mid and y > y_mid) {
-                    ++quadrant[3];
-                }
+                add_to_quadrant(quadrant, robot);
             }
 
             return sr::fold_left(quadrant, 1uz, std::multiplies{});
         }
 
+        QuadrantSink stream_part_one(common::Context /* ctx */) const { return {}; }
+
         // assuming the tree is filled, not just an outline
-        Output solve_part_two(Input input, common::Context ctx) const
+        Output solve_part_two(const Input& input, common::Context ctx) const
         {
             const auto [w, h] = map_size;
 
@@ -197,6 +214,8 @@ namespace aoc::day
             auto highest_index = 0_i64;
 
             for (auto i : sv::iota(0_i64, w * h)) {
+                AOC_TRACE_SCOPE("frame");
+
                 for (auto& robot : robots) {
                     auto pos = robot.move(1, map_size).m_pos;
                     scratch_map.inc_no_wrap(pos);
@@ -225,4 +244,5 @@ namespace aoc::day
     };
 
     static_assert(common::Day<Day14>);
+    static_assert(common::StreamingPartOne<Day14>);
 }
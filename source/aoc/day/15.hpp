@@ -486,8 +486,9 @@ namespace aoc::day
 
     struct Day15
     {
-        static constexpr auto id   = "15";
-        static constexpr auto name = "warehouse-woes";
+        static constexpr auto id               = "15";
+        static constexpr auto name             = "warehouse-woes";
+        static constexpr auto snapshot_version = 1u;
 
         using Coord         = day15::Coord;
         using Thing         = day15::Thing;
@@ -577,7 +578,41 @@ namespace aoc::day
             };
         }
 
-        Output solve_part_one(Input input, common::Context ctx) const
+        void save_snapshot(const Input& input, util::SnapshotWriter& writer) const
+        {
+            const auto& [robot_pos, warehouse, movements] = input;
+
+            writer.write(robot_pos);
+            writer.write(warehouse.m_width);
+            writer.write(warehouse.m_height);
+            writer.write_span(std::span{ warehouse.m_data });
+            writer.write_span(std::span{ movements });
+        }
+
+        Input load_snapshot(util::SnapshotReader& reader, common::Context /* ctx */) const
+        {
+            auto robot_pos = reader.read<Coord>();
+            auto width     = reader.read<al::usize>();
+            auto height    = reader.read<al::usize>();
+            auto things    = reader.read_span<Thing>();
+            auto movements = reader.read_span<MovementStep>();
+
+            if (things.size() != width * height) {
+                throw util::SnapshotError{ "snapshot warehouse size mismatch" };
+            }
+
+            auto warehouse = Warehouse{ width, height };
+            sr::copy(things, warehouse.m_data.begin());
+
+            return {
+                .m_robot_pos = robot_pos,
+                .m_warehouse = std::move(warehouse),
+                .m_movements = { movements.begin(), movements.end() },
+            };
+        }
+
+        // consumes the input: the warehouse is moved around in place
+        Output solve_part_one(Input&& input, common::Context ctx) const
         {
             auto&& [robot_pos, warehouse, movements] = input;
 
@@ -593,12 +628,12 @@ namespace aoc::day
             return warehouse.gps_score();
         }
 
-        Output solve_part_two(Input input, common::Context ctx) const
+        Output solve_part_two(const Input& input, common::Context ctx) const
         {
-            auto&& [robot_pos, warehouse, movements] = input;
+            auto&& [start_pos, warehouse, movements] = input;
 
             auto wide_warehouse = day15::widen(warehouse);
-            robot_pos           = { robot_pos.m_x * 2, robot_pos.m_y };
+            auto robot_pos      = Coord{ start_pos.m_x * 2, start_pos.m_y };
 
             for (const auto& [movement, steps] : movements) {
                 robot_pos = wide_warehouse.move(robot_pos, movement, steps);
@@ -614,4 +649,5 @@ namespace aoc::day
     };
 
     static_assert(common::Day<Day15>);
+    static_assert(common::Snapshotable<Day15>);
 }
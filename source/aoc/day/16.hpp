@@ -4,6 +4,7 @@
 #include "common.hpp"
 #include "util.hpp"
 
+#include <memory_resource>
 #include <queue>
 #include <unordered_set>
 #include <vector>
@@ -11,6 +12,7 @@
 namespace aoc::day
 {
     namespace al  = aoc::aliases;
+    namespace sr  = aoc::common::sr;
     namespace sv  = aoc::common::sv;
     namespace cnp = aoc::concepts;
 
@@ -41,7 +43,7 @@ namespace aoc::day
 
             bool bounded(const Coord& coord) const { return coord.m_x < m_width and coord.m_y < m_height; }
 
-            void print(const std::unordered_set<Coord>* best_paths) const
+            void print(const std::pmr::unordered_set<Coord>* best_paths) const
             {
                 for (auto [c, v] : util::Array2D<Tile>::iter_enumerate()) {
                     if (best_paths and best_paths->contains(c)) {
@@ -80,7 +82,7 @@ namespace aoc::day
         struct BestScoreMap
         {
             using Dirs   = std::array<al::usize, 4>;
-            using Scores = util::Array2D<Dirs>;
+            using Scores = util::pmr::Array2D<Dirs>;
 
             static constexpr auto default_scores = Dirs{
                 std::numeric_limits<al::usize>::min(),
@@ -89,8 +91,8 @@ namespace aoc::day
                 std::numeric_limits<al::usize>::min(),
             };
 
-            BestScoreMap(al::usize width, al::usize height)
-                : m_scores{ width, height, default_scores }
+            BestScoreMap(al::usize width, al::usize height, std::pmr::memory_resource* memory)
+                : m_scores{ width, height, default_scores, memory }
             {
             }
 
@@ -107,10 +109,10 @@ namespace aoc::day
         struct Visited
         {
             using Dirs   = al::u8;
-            using Visits = util::Array2D<Dirs>;
+            using Visits = util::pmr::Array2D<Dirs>;
 
-            Visited(al::usize width, al::usize height)
-                : m_visits{ width, height, 0 }
+            Visited(al::usize width, al::usize height, std::pmr::memory_resource* memory)
+                : m_visits{ width, height, 0, memory }
             {
             }
 
@@ -138,7 +140,7 @@ namespace aoc::day
             bool operator()(const S& p1, const S& p2) const { return p1.m_score > p2.m_score; }
         };
 
-        using PriorityQueue = std::priority_queue<ScoredCoord, std::vector<ScoredCoord>, Compare>;
+        using PriorityQueue = std::priority_queue<ScoredCoord, std::pmr::vector<ScoredCoord>, Compare>;
 
         constexpr auto moves = std::array<DirectedCoord, 4>{ {
             { .m_coord = { 0uz, -1uz }, .m_dir = Direction::North },
@@ -153,11 +155,18 @@ namespace aoc::day
             return moves[udir].m_coord;
         }
 
+        // the queue and the visited map are allocated from `memory`
         template <cnp::Fn<void, PriorityQueue&, const ScoredCoord&> Logic>
-        std::optional<ScoredCoord> dijkstra(const Map& map, ScoredCoord start, Coord end, Logic logic)
+        std::optional<ScoredCoord> dijkstra(
+            const Map&                 map,
+            ScoredCoord                start,
+            Coord                      end,
+            Logic                      logic,
+            std::pmr::memory_resource* memory
+        )
         {
-            auto priority_queue = PriorityQueue{};
-            auto visited        = Visited{ map.m_width, map.m_height };
+            auto priority_queue = PriorityQueue{ Compare{}, std::pmr::vector<ScoredCoord>{ memory } };
+            auto visited        = Visited{ map.m_width, map.m_height, memory };
 
             priority_queue.push(start);
 
@@ -194,8 +203,9 @@ namespace aoc::day
     /// https://github.com/vss2sn/advent_of_code/blob/f94d7f5ca09e351e5f7698a2d26776307fdca229/2024/cpp/day_16b.cpp
     struct Day16
     {
-        static constexpr auto id   = "16";
-        static constexpr auto name = "reindeer-maze";
+        static constexpr auto id               = "16";
+        static constexpr auto name             = "reindeer-maze";
+        static constexpr auto snapshot_version = 1u;
 
         static constexpr auto score_step      = 1;
         static constexpr auto score_turn      = 1000;
@@ -250,7 +260,36 @@ namespace aoc::day
             return { *start, *end, std::move(map) };
         }
 
-        Output solve_part_one(Input input, common::Context /* ctx */) const
+        void save_snapshot(const Input& input, util::SnapshotWriter& writer) const
+        {
+            const auto& [start, end, map] = input;
+
+            writer.write(start);
+            writer.write(end);
+            writer.write(map.m_width);
+            writer.write(map.m_height);
+            writer.write_span(std::span{ map.m_elems });
+        }
+
+        Input load_snapshot(util::SnapshotReader& reader, common::Context /* ctx */) const
+        {
+            auto start  = reader.read<DirectedCoord>();
+            auto end    = reader.read<Coord>();
+            auto width  = reader.read<al::usize>();
+            auto height = reader.read<al::usize>();
+            auto tiles  = reader.read_span<Tile>();
+
+            if (tiles.size() != width * height) {
+                throw util::SnapshotError{ "snapshot map size mismatch" };
+            }
+
+            auto map = Map{ width, height, Tile::Empty };
+            sr::copy(tiles, map.m_elems.begin());
+
+            return { start, end, std::move(map) };
+        }
+
+        Output solve_part_one(const Input& input, common::Context ctx) const
         {
             auto&& [start, end, map] = input;
 
@@ -278,15 +317,23 @@ namespace aoc::day
                 }
             };
 
-            return day16::dijkstra(map, { start, 0 }, end, logic)
+            return day16::dijkstra(map, { start, 0 }, end, logic, ctx.memory())
                 .transform(al::Proj{ &ScoredCoord::m_score });
         }
 
-        Output solve_part_two(Input input, common::Context ctx) const
+        Output solve_part_two(const Input& input, common::Context ctx) const
+        {
+            return solve_both(input, ctx).second;
+        }
+
+        // part two starts with the same search as part one, the score of the end is part one's answer
+        std::pair<Output, Output> solve_both(const Input& input, common::Context ctx) const
         {
             auto&& [start, end, map] = input;
 
             auto reach_end = [&]() -> std::optional<ScoredCoord> {
+                AOC_TRACE_SCOPE("reach end");
+
                 auto logic = [&](PriorityQueue& pq, const ScoredCoord& current) {
                     auto [dir_coord, score] = current;
 
@@ -311,11 +358,13 @@ namespace aoc::day
                     }
                 };
 
-                return day16::dijkstra(map, { start, 0 }, end, logic);
+                return day16::dijkstra(map, { start, 0 }, end, logic, ctx.memory());
             };
 
             auto find_best_score_for_all = [&](DirectedCoord new_start) -> BestScoreMap {
-                auto best_score_map = BestScoreMap{ map.m_width, map.m_height };
+                AOC_TRACE_SCOPE("best scores from end");
+
+                auto best_score_map = BestScoreMap{ map.m_width, map.m_height, ctx.memory() };
 
                 auto logic = [&](PriorityQueue& pq, const ScoredCoord& current) {
                     best_score_map.at(current.m_dir_coord) = current.m_score;
@@ -351,14 +400,16 @@ namespace aoc::day
                 };
 
                 // unreachable_end since I want to traverse all paths
-                auto end = day16::dijkstra(map, { new_start, 0 }, unreachable_end, logic);
+                auto end = day16::dijkstra(map, { new_start, 0 }, unreachable_end, logic, ctx.memory());
                 ASSERT(not end.has_value(), "end should not be reached");
 
                 return best_score_map;
             };
 
-            auto traverse_all_best_path = [&](const BestScoreMap& best_scores) -> std::unordered_set<Coord> {
-                auto visited = std::unordered_set<Coord>{};
+            auto traverse_all_best_path = [&](const BestScoreMap& best_scores) -> std::pmr::unordered_set<Coord> {
+                AOC_TRACE_SCOPE("walk best paths");
+
+                auto visited = std::pmr::unordered_set<Coord>{ ctx.memory() };
 
                 auto logic = [&](PriorityQueue& pq, const ScoredCoord& current) {
                     auto [dir_coord, score] = current;
@@ -393,7 +444,7 @@ namespace aoc::day
                 };
 
                 auto best = best_scores.at(start);
-                auto end  = day16::dijkstra(map, { start, best }, unreachable_end, logic);
+                auto end  = day16::dijkstra(map, { start, best }, unreachable_end, logic, ctx.memory());
                 ASSERT(not end.has_value(), "end should not be reached");
 
                 return visited;
@@ -401,7 +452,7 @@ namespace aoc::day
 
             auto end_scored_coord = reach_end();
             if (not end_scored_coord.has_value()) {
-                return std::nullopt;
+                return { std::nullopt, std::nullopt };
             }
 
             auto best_score_map = find_best_score_for_all(end_scored_coord->m_dir_coord);
@@ -411,9 +462,11 @@ namespace aoc::day
                 map.print(&best_paths);
             }
 
-            return best_paths.size();
+            return { end_scored_coord->m_score, best_paths.size() };
         }
     };
 
     static_assert(common::Day<Day16>);
+    static_assert(common::SolveBoth<Day16>);
+    static_assert(common::Snapshotable<Day16>);
 }
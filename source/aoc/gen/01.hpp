@@ -0,0 +1,27 @@
+#pragma once
+
+#include "gen/generator.hpp"
+
+namespace aoc::gen
+{
+    // two columns of 5-digit location ids; the right column reuses left ids so part two has something to count
+    struct Gen01
+    {
+        static constexpr auto id           = "01";
+        static constexpr auto size_unit    = "lines";
+        static constexpr auto default_size = 1000uz;
+
+        void generate(std::string& out, Rng& rng, al::usize size) const
+        {
+            auto left = std::vector<al::i32>(size);
+            for (auto& id : left) {
+                id = uniform(rng, 10000, 99999);
+            }
+
+            for (auto i = 0uz; i < size; ++i) {
+                auto right = chance(rng, 0.3) ? left[uniform(rng, 0uz, size - 1)] : uniform(rng, 10000, 99999);
+                put(out, "{}   {}\n", left[i], right);
+            }
+        }
+    };
+}
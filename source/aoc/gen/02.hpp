@@ -0,0 +1,32 @@
+#pragma once
+
+#include "day/02.hpp"
+#include "gen/generator.hpp"
+
+namespace aoc::gen
+{
+    // reports of 5 up to Day02::max_size levels, mostly monotonic so every kind of (un)safe report shows up
+    struct Gen02
+    {
+        static constexpr auto id           = "02";
+        static constexpr auto size_unit    = "reports";
+        static constexpr auto default_size = 1000uz;
+
+        void generate(std::string& out, Rng& rng, al::usize size) const
+        {
+            for (auto _ : std::views::iota(0uz, size)) {
+                auto count = uniform(rng, 5uz, day::Day02::max_size);
+                auto sign  = chance(rng, 0.5) ? 1 : -1;
+                auto level = uniform(rng, 45, 55);    // stays positive, at most 8 steps of 5
+
+                for (auto i = 0uz; i < count; ++i) {
+                    put(out, "{}{}", level, i + 1 < count ? ' ' : '\n');
+
+                    // a step out of [1, 3] or against the direction every now and then
+                    auto step  = chance(rng, 0.9) ? uniform(rng, 1, 3) : uniform(rng, -2, 5);
+                    level     += sign * step;
+                }
+            }
+        }
+    };
+}
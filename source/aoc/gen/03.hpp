@@ -0,0 +1,40 @@
+#pragma once
+
+#include "gen/generator.hpp"
+
+namespace aoc::gen
+{
+    // corrupted memory: noise with well-formed and malformed mul(), do() and don't() instructions mixed in
+    struct Gen03
+    {
+        static constexpr auto id           = "03";
+        static constexpr auto size_unit    = "lines of ~3000 characters";
+        static constexpr auto default_size = 6uz;
+
+        static constexpr auto line_length = 3000uz;
+        static constexpr auto noise       = std::string_view{ "abcdmulon't()[]{}<>,;:'!@#$%^&*-+?/ 0123456789" };
+
+        void generate(std::string& out, Rng& rng, al::usize size) const
+        {
+            for (auto _ : std::views::iota(0uz, size)) {
+                auto start = out.size();
+
+                // Day03 scans in windows of 3 characters, so a line is never shorter than 4
+                while (out.size() - start < line_length) {
+                    switch (uniform(rng, 0, 9)) {
+                    case 0: put(out, "mul({},{})", uniform(rng, 1, 999), uniform(rng, 1, 999)); break;
+                    case 1: put(out, "mul({},{}]", uniform(rng, 1, 999), uniform(rng, 1, 999)); break;
+                    case 2: put(out, "mul ( {},{})", uniform(rng, 1, 999), uniform(rng, 1, 999)); break;
+                    case 3: out.append(chance(rng, 0.5) ? "do()" : "don't()"); break;
+                    default: {
+                        for (auto _ : std::views::iota(0, uniform(rng, 1, 12))) {
+                            out.push_back(pick(rng, noise));
+                        }
+                    }
+                    }
+                }
+                out.push_back('\n');
+            }
+        }
+    };
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "gen/generator.hpp"
+
+namespace aoc::gen
+{
+    // a square word search of the letters of XMAS
+    struct Gen04
+    {
+        static constexpr auto id           = "04";
+        static constexpr auto size_unit    = "grid side";
+        static constexpr auto default_size = 140uz;
+
+        void generate(std::string& out, Rng& rng, al::usize size) const
+        {
+            auto grid = Grid{ size, size, '.' };
+            for (auto& cell : grid.m_cells) {
+                cell = pick(rng, "XMAS");
+            }
+            grid.write(out);
+        }
+    };
+}
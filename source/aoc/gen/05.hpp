@@ -0,0 +1,73 @@
+#pragma once
+
+#include "day/05.hpp"
+#include "gen/generator.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace aoc::gen
+{
+    // the rules form a circular tournament over an odd number of pages: a page comes before the next half of the
+    // circle. every page has rules (Day05 looks them up with at()) and every update is drawn from within half a
+    // circle, where the rules are a total order, so there is always a single correct ordering
+    struct Gen05
+    {
+        static constexpr auto id           = "05";
+        static constexpr auto size_unit    = "updates";
+        static constexpr auto default_size = 200uz;
+
+        static constexpr auto page_count = 49uz;
+        static constexpr auto half       = page_count / 2;
+
+        void generate(std::string& out, Rng& rng, al::usize size) const
+        {
+            static_assert(page_count % 2 == 1 and day::Day05::max_line_len <= half + 1);
+
+            // two digit page numbers, circle position -> page
+            auto pages = std::vector<al::u32>(90);
+            std::iota(pages.begin(), pages.end(), 10u);
+            std::ranges::shuffle(pages, rng);
+            pages.resize(page_count);
+
+            auto rules = std::vector<std::pair<al::u32, al::u32>>{};
+            for (auto i = 0uz; i < page_count; ++i) {
+                for (auto d = 1uz; d <= half; ++d) {
+                    rules.emplace_back(pages[i], pages[(i + d) % page_count]);
+                }
+            }
+            std::ranges::shuffle(rules, rng);
+
+            for (auto [before, after] : rules) {
+                put(out, "{}|{}\n", before, after);
+            }
+            out.push_back('\n');
+
+            auto offsets = std::vector<al::usize>(half + 1);
+            auto update  = std::vector<al::u32>{};
+
+            for (auto _ : std::views::iota(0uz, size)) {
+                auto count = 2 * uniform(rng, 2uz, (day::Day05::max_line_len - 1) / 2) + 1;    // odd, 5 and up
+                auto start = uniform(rng, 0uz, page_count - 1);
+
+                std::iota(offsets.begin(), offsets.end(), 0uz);
+                std::ranges::shuffle(offsets, rng);
+                std::ranges::sort(offsets.begin(), offsets.begin() + static_cast<al::isize>(count));
+
+                update.clear();
+                for (auto offset : offsets | std::views::take(count)) {
+                    update.push_back(pages[(start + offset) % page_count]);
+                }
+
+                // about half of them correctly ordered
+                if (chance(rng, 0.5)) {
+                    std::ranges::shuffle(update, rng);
+                }
+
+                for (auto i = 0uz; i < update.size(); ++i) {
+                    put(out, "{}{}", update[i], i + 1 < update.size() ? ',' : '\n');
+                }
+            }
+        }
+    };
+}
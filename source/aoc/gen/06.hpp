@@ -0,0 +1,85 @@
+#pragma once
+
+#include "gen/generator.hpp"
+
+#include <array>
+#include <stdexcept>
+
+namespace aoc::gen
+{
+    // sparse obstructions with the guard facing up; Day06 part one assumes the guard eventually walks out of the
+    // map, so the patrol is simulated and the map regenerated until it does. past `max_attempts` the column above
+    // the guard of the last one is cleared instead, it then walks straight out
+    struct Gen06
+    {
+        static constexpr auto id           = "06";
+        static constexpr auto size_unit    = "grid side";
+        static constexpr auto default_size = 130uz;
+
+        static constexpr auto density      = 0.03;
+        static constexpr auto max_attempts = 100uz;
+
+        // throws std::invalid_argument if `size` is less than 2
+        void generate(std::string& out, Rng& rng, al::usize size) const
+        {
+            if (size < 2) {
+                throw std::invalid_argument{ "the grid side must be at least 2" };
+            }
+
+            auto grid = Grid{ size, size, '.' };
+
+            for (auto attempt = 1uz;; ++attempt) {
+                for (auto& cell : grid.m_cells) {
+                    cell = chance(rng, density) ? '#' : '.';
+                }
+
+                auto x = uniform(rng, 0uz, size - 1);
+                auto y = uniform(rng, 0uz, size - 1);
+
+                grid[x, y] = '^';
+                if (leaves_map(grid, x, y)) {
+                    break;
+                } else if (attempt == max_attempts) {
+                    for (auto above = 0uz; above < y; ++above) {
+                        grid[x, above] = '.';
+                    }
+                    break;
+                }
+            }
+
+            grid.write(out);
+        }
+
+        static bool leaves_map(const Grid& grid, al::usize x, al::usize y)
+        {
+            constexpr auto dx = std::array{ 0, 1, 0, -1 };    // up, right, down, left
+            constexpr auto dy = std::array{ -1, 0, 1, 0 };
+
+            // bit `dir` set if the guard has been on the cell facing `dir`
+            auto seen = std::vector<al::u8>(grid.m_cells.size(), 0);
+            auto dir  = 0uz;
+
+            while (true) {
+                auto& state = seen[y * grid.m_width + x];
+                if (state & (1u << dir)) {
+                    return false;
+                }
+                state = static_cast<al::u8>(state | (1u << dir));
+
+                // unsigned wrap around on the top/left edge ends up out of bound too
+                auto nx = x + static_cast<al::usize>(dx[dir]);
+                auto ny = y + static_cast<al::usize>(dy[dir]);
+                if (nx >= grid.m_width or ny >= grid.m_height) {
+                    return true;
+                }
+
+                if (grid[nx, ny] == '#') {
+                    dir = (dir + 1) % 4;
+                } else {
+                    x = nx;
+                    y = ny;
+                }
+            }
+        }
+    };
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "day/07.hpp"
+#include "gen/generator.hpp"
+
+#include <optional>
+#include <span>
+
+namespace aoc::gen
+{
+    // up to Day07::max_operands operands of at most 3 digits (Day07 concatenation assumes it); the expected value
+    // comes from random +, * and || operators, rerolled until it fits comfortably in u64, and is sometimes made
+    // unreachable with an offset
+    struct Gen07
+    {
+        static constexpr auto id           = "07";
+        static constexpr auto size_unit    = "equations";
+        static constexpr auto default_size = 850uz;
+
+        static constexpr auto max_expect = 1'000'000'000'000'000ull;
+
+        void generate(std::string& out, Rng& rng, al::usize size) const
+        {
+            auto operands = std::vector<al::u64>{};
+
+            for (auto _ : std::views::iota(0uz, size)) {
+                auto expect = 0ull;
+
+                while (true) {
+                    auto count = uniform(rng, 2uz, day::Day07::max_operands);
+
+                    operands.clear();
+                    for (auto i = 0uz; i < count; ++i) {
+                        operands.push_back(uniform(rng, 1ull, chance(rng, 0.7) ? 99ull : 999ull));
+                    }
+
+                    if (auto res = evaluate(rng, operands); res.has_value()) {
+                        expect = *res + (chance(rng, 0.4) ? uniform(rng, 1ull, 10ull) : 0ull);
+                        break;
+                    }
+                }
+
+                put(out, "{}:", expect);
+                for (auto operand : operands) {
+                    put(out, " {}", operand);
+                }
+                out.push_back('\n');
+            }
+        }
+
+        // std::nullopt if the result gets too big
+        static std::optional<al::u64> evaluate(Rng& rng, std::span<const al::u64> operands)
+        {
+            auto result = static_cast<unsigned __int128>(operands[0]);
+
+            for (auto operand : operands | std::views::drop(1)) {
+                switch (uniform(rng, 0, 2)) {
+                case 0: result += operand; break;
+                case 1: result *= operand; break;
+                case 2: result = result * (operand < 10 ? 10 : operand < 100 ? 100 : 1000) + operand; break;
+                }
+
+                if (result > max_expect) {
+                    return std::nullopt;
+                }
+            }
+
+            return static_cast<al::u64>(result);
+        }
+    };
+}
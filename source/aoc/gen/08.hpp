@@ -0,0 +1,31 @@
+#pragma once
+
+#include "gen/generator.hpp"
+
+namespace aoc::gen
+{
+    // a few antennas per frequency (digits and letters) scattered over an empty map
+    struct Gen08
+    {
+        static constexpr auto id           = "08";
+        static constexpr auto size_unit    = "grid side";
+        static constexpr auto default_size = 50uz;
+
+        static constexpr auto frequencies = std::string_view{
+            "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"
+        };
+
+        void generate(std::string& out, Rng& rng, al::usize size) const
+        {
+            auto grid = Grid{ size, size, '.' };
+
+            // about the density of the puzzle input: ~200 antennas on a 50x50 map
+            auto count = std::max(size * size / 12, 2uz);
+            for (auto _ : std::views::iota(0uz, count)) {
+                grid[uniform(rng, 0uz, size - 1), uniform(rng, 0uz, size - 1)] = pick(rng, frequencies);
+            }
+
+            grid.write(out);
+        }
+    };
+}
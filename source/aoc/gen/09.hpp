@@ -0,0 +1,25 @@
+#pragma once
+
+#include "gen/generator.hpp"
+
+namespace aoc::gen
+{
+    // a disk map alternating file (1-9 blocks) and free space (0-9 blocks), ending with a file
+    struct Gen09
+    {
+        static constexpr auto id           = "09";
+        static constexpr auto size_unit    = "digits";
+        static constexpr auto default_size = 19999uz;
+
+        void generate(std::string& out, Rng& rng, al::usize size) const
+        {
+            size = size | 1;    // odd, so the last one is a file
+
+            out.reserve(out.size() + size + 1);
+            for (auto i = 0uz; i < size; ++i) {
+                out.push_back(static_cast<char>('0' + (i % 2 == 0 ? uniform(rng, 1, 9) : uniform(rng, 0, 9))));
+            }
+            out.push_back('\n');
+        }
+    };
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "gen/generator.hpp"
+
+#include <array>
+
+namespace aoc::gen
+{
+    // noise with hiking trails (0 to 9, one step up at a time) carved in as random walks
+    struct Gen10
+    {
+        static constexpr auto id           = "10";
+        static constexpr auto size_unit    = "grid side";
+        static constexpr auto default_size = 50uz;
+
+        void generate(std::string& out, Rng& rng, al::usize size) const
+        {
+            constexpr auto dx = std::array{ 0, 1, 0, -1 };
+            constexpr auto dy = std::array{ -1, 0, 1, 0 };
+
+            auto grid = Grid{ size, size, '.' };
+            for (auto& cell : grid.m_cells) {
+                cell = static_cast<char>('0' + uniform(rng, 0, 9));
+            }
+
+            auto trails = std::max(size * size / 10, 1uz);
+            for (auto _ : std::views::iota(0uz, trails)) {
+                auto x = uniform(rng, 0uz, size - 1);
+                auto y = uniform(rng, 0uz, size - 1);
+
+                for (auto height = '0'; height <= '9'; ++height) {
+                    grid[x, y] = height;
+
+                    // a step that goes out of the map is just not taken, the trail gets shorter
+                    auto dir = uniform(rng, 0uz, 3uz);
+                    auto nx  = x + static_cast<al::usize>(dx[dir]);
+                    auto ny  = y + static_cast<al::usize>(dy[dir]);
+                    if (nx >= size or ny >= size) {
+                        break;
+                    }
+                    x = nx;
+                    y = ny;
+                }
+            }
+
+            grid.write(out);
+        }
+    };
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "gen/generator.hpp"
+
+namespace aoc::gen
+{
+    // stones engraved with numbers below 10^7 like the puzzle input, a few of them zero
+    struct Gen11
+    {
+        static constexpr auto id           = "11";
+        static constexpr auto size_unit    = "stones";
+        static constexpr auto default_size = 8uz;
+
+        void generate(std::string& out, Rng& rng, al::usize size) const
+        {
+            for (auto i = 0uz; i < size; ++i) {
+                auto stone = chance(rng, 0.05) ? 0ull : uniform(rng, 1ull, 9'999'999ull);
+                put(out, "{}{}", stone, i + 1 < size ? ' ' : '\n');
+            }
+        }
+    };
+}
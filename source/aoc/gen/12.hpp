@@ -0,0 +1,38 @@
+#pragma once
+
+#include "gen/generator.hpp"
+
+namespace aoc::gen
+{
+    // plots of letters grown from a coarse grid of blocks with jittered borders, giving irregular regions with
+    // holes and enclaves
+    struct Gen12
+    {
+        static constexpr auto id           = "12";
+        static constexpr auto size_unit    = "grid side";
+        static constexpr auto default_size = 140uz;
+
+        static constexpr auto block  = 8uz;
+        static constexpr auto jitter = 3uz;
+
+        void generate(std::string& out, Rng& rng, al::usize size) const
+        {
+            auto blocks_side = (size + jitter) / block + 1;
+            auto blocks      = Grid{ blocks_side, blocks_side, 'A' };
+            for (auto& plant : blocks.m_cells) {
+                plant = static_cast<char>('A' + uniform(rng, 0, 25));
+            }
+
+            auto grid = Grid{ size, size, 'A' };
+            for (auto y = 0uz; y < size; ++y) {
+                for (auto x = 0uz; x < size; ++x) {
+                    auto bx    = (x + uniform(rng, 0uz, jitter)) / block;
+                    auto by    = (y + uniform(rng, 0uz, jitter)) / block;
+                    grid[x, y] = blocks[bx, by];
+                }
+            }
+
+            grid.write(out);
+        }
+    };
+}
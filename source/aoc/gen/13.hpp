@@ -0,0 +1,44 @@
+#pragma once
+
+#include "gen/generator.hpp"
+
+#include <tuple>
+#include <utility>
+
+namespace aoc::gen
+{
+    // claw machines with linearly independent buttons (Day13 solves them with Cramer's rule and divides by the
+    // determinant); about half of the prizes are reachable
+    struct Gen13
+    {
+        static constexpr auto id           = "13";
+        static constexpr auto size_unit    = "machines";
+        static constexpr auto default_size = 320uz;
+
+        void generate(std::string& out, Rng& rng, al::usize size) const
+        {
+            auto step   = [&] { return uniform<al::i64>(rng, 10, 99); };
+            auto button = [&] { return std::pair{ step(), step() }; };    // braced: evaluated in order
+
+            for (auto i = 0uz; i < size; ++i) {
+                auto [ax, ay] = button();
+                auto [bx, by] = button();
+                while (ax * by - ay * bx == 0) {
+                    std::tie(bx, by) = button();
+                }
+
+                auto na = uniform<al::i64>(rng, 1, 100);
+                auto nb = uniform<al::i64>(rng, 1, 100);
+                auto px = ax * na + bx * nb + (chance(rng, 0.5) ? 0 : uniform<al::i64>(rng, 1, 50));
+                auto py = ay * na + by * nb;
+
+                if (i != 0) {
+                    out.push_back('\n');
+                }
+                put(out, "Button A: X+{}, Y+{}\n", ax, ay);
+                put(out, "Button B: X+{}, Y+{}\n", bx, by);
+                put(out, "Prize: X={}, Y={}\n", px, py);
+            }
+        }
+    };
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "day/14.hpp"
+#include "gen/generator.hpp"
+
+namespace aoc::gen
+{
+    // robots anywhere on the fixed Day14::map_size floor with velocities below the floor size
+    struct Gen14
+    {
+        static constexpr auto id           = "14";
+        static constexpr auto size_unit    = "robots";
+        static constexpr auto default_size = 500uz;
+
+        void generate(std::string& out, Rng& rng, al::usize size) const
+        {
+            const auto [w, h] = day::Day14::map_size;
+
+            for (auto _ : std::views::iota(0uz, size)) {
+                auto px = uniform<al::i64>(rng, 0, w - 1);
+                auto py = uniform<al::i64>(rng, 0, h - 1);
+                auto vx = uniform<al::i64>(rng, 1 - w, w - 1);
+                auto vy = uniform<al::i64>(rng, 1 - h, h - 1);
+                put(out, "p={},{} v={},{}\n", px, py, vx, vy);
+            }
+        }
+    };
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "gen/generator.hpp"
+
+#include <algorithm>
+
+namespace aoc::gen
+{
+    // a warehouse closed by walls with scattered walls and boxes, then the moves in lines of 1000. Day15 finds
+    // the bottom wall as the first line made only of '#', so no inner row is allowed to be all walls
+    struct Gen15
+    {
+        static constexpr auto id           = "15";
+        static constexpr auto size_unit    = "grid side (8 moves per cell)";
+        static constexpr auto default_size = 48uz;
+
+        static constexpr auto moves_per_cell = 8uz;
+        static constexpr auto moves_per_line = 1000uz;
+
+        void generate(std::string& out, Rng& rng, al::usize size) const
+        {
+            size = std::max(size, 1uz);
+
+            auto side = size + 2;
+            auto grid = Grid{ side, side, '#' };
+
+            for (auto y = 1uz; y <= size; ++y) {
+                for (auto x = 1uz; x <= size; ++x) {
+                    auto roll  = uniform(rng, 0, 99);
+                    grid[x, y] = roll < 8 ? '#' : roll < 33 ? 'O' : '.';
+                }
+                grid[uniform(rng, 1uz, size), y] = '.';
+            }
+            grid[uniform(rng, 1uz, size), uniform(rng, 1uz, size)] = '@';
+
+            grid.write(out);
+            out.push_back('\n');
+
+            auto moves = moves_per_cell * size * size;
+            for (auto i = 0uz; i < moves; ++i) {
+                out.push_back(pick(rng, "^>v<"));
+                if ((i + 1) % moves_per_line == 0 or i + 1 == moves) {
+                    out.push_back('\n');
+                }
+            }
+        }
+    };
+}
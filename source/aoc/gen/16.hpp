@@ -0,0 +1,75 @@
+#pragma once
+
+#include "gen/generator.hpp"
+
+#include <array>
+
+namespace aoc::gen
+{
+    // a maze carved by a randomized depth-first search on the odd cells of an odd sized map, with some extra
+    // walls knocked down so there are several best paths; S at the bottom left, E at the top right
+    struct Gen16
+    {
+        static constexpr auto id           = "16";
+        static constexpr auto size_unit    = "grid side";
+        static constexpr auto default_size = 141uz;
+
+        static constexpr auto extra_openings = 0.05;
+
+        void generate(std::string& out, Rng& rng, al::usize size) const
+        {
+            constexpr auto dx = std::array{ 0, 2, 0, -2 };
+            constexpr auto dy = std::array{ -2, 0, 2, 0 };
+
+            size = std::max(size | 1, 5uz);
+
+            auto grid  = Grid{ size, size, '#' };
+            auto stack = std::vector<std::pair<al::usize, al::usize>>{ { 1, size - 2 } };
+
+            grid[1, size - 2] = '.';
+
+            // iterative, a big maze is far deeper than the call stack
+            while (not stack.empty()) {
+                auto [x, y] = stack.back();
+
+                auto options = std::array<al::usize, 4>{};
+                auto count   = 0uz;
+
+                for (auto dir = 0uz; dir < 4; ++dir) {
+                    auto nx = x + static_cast<al::usize>(dx[dir]);
+                    auto ny = y + static_cast<al::usize>(dy[dir]);
+                    if (nx < size - 1 and ny < size - 1 and grid[nx, ny] == '#') {
+                        options[count++] = dir;
+                    }
+                }
+
+                if (count == 0) {
+                    stack.pop_back();
+                    continue;
+                }
+
+                auto dir = options[uniform(rng, 0uz, count - 1)];
+                auto nx  = x + static_cast<al::usize>(dx[dir]);
+                auto ny  = y + static_cast<al::usize>(dy[dir]);
+
+                grid[(x + nx) / 2, (y + ny) / 2] = '.';
+                grid[nx, ny]                     = '.';
+                stack.emplace_back(nx, ny);
+            }
+
+            // the walls between two cells sit at one odd and one even coordinate
+            for (auto y = 1uz; y < size - 1; ++y) {
+                for (auto x = 1uz + y % 2; x < size - 1; x += 2) {
+                    if (grid[x, y] == '#' and chance(rng, extra_openings)) {
+                        grid[x, y] = '.';
+                    }
+                }
+            }
+
+            grid[1, size - 2] = 'S';
+            grid[size - 2, 1] = 'E';
+
+            grid.write(out);
+        }
+    };
+}
@@ -0,0 +1,37 @@
+#include "gen/01.hpp"
+#include "gen/02.hpp"
+#include "gen/03.hpp"
+#include "gen/04.hpp"
+#include "gen/05.hpp"
+#include "gen/06.hpp"
+#include "gen/07.hpp"
+#include "gen/08.hpp"
+#include "gen/09.hpp"
+#include "gen/10.hpp"
+#include "gen/11.hpp"
+#include "gen/12.hpp"
+#include "gen/13.hpp"
+#include "gen/14.hpp"
+#include "gen/15.hpp"
+#include "gen/16.hpp"
+
+namespace aoc::gen
+{
+    using Generators = std::tuple<
+        Gen01,
+        Gen02,
+        Gen03,
+        Gen04,
+        Gen05,
+        Gen06,
+        Gen07,
+        Gen08,
+        Gen09,
+        Gen10,
+        Gen11,
+        Gen12,
+        Gen13,
+        Gen14,
+        Gen15,
+        Gen16>;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "aliases.hpp"
+
+#include <fmt/format.h>
+
+#include <concepts>
+#include <iterator>
+#include <random>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aoc::gen
+{
+    namespace al = aoc::aliases;
+
+    using Rng = std::mt19937_64;
+
+    // writes a valid input for the day with the same id into `out`, what `size` counts is described by
+    // `size_unit`; the same seed and size give the same input (with the same standard library)
+    template <typename T>
+    concept Generator = requires (const T ct, std::string& out, Rng& rng, al::usize size) {
+        requires std::semiregular<T>;
+
+        { T::id } -> std::convertible_to<std::string_view>;
+        { T::size_unit } -> std::convertible_to<std::string_view>;
+        { T::default_size } -> std::convertible_to<al::usize>;
+
+        ct.generate(out, rng, size);
+    };
+
+    // inclusive on both ends
+    template <std::integral T>
+    T uniform(Rng& rng, T lo, T hi)
+    {
+        return std::uniform_int_distribution<T>{ lo, hi }(rng);
+    }
+
+    inline bool chance(Rng& rng, double probability)
+    {
+        return std::bernoulli_distribution{ probability }(rng);
+    }
+
+    inline char pick(Rng& rng, std::string_view chars)
+    {
+        return chars[uniform(rng, 0uz, chars.size() - 1)];
+    }
+
+    template <typename... Args>
+    void put(std::string& out, fmt::format_string<Args...> format, Args&&... args)
+    {
+        fmt::format_to(std::back_inserter(out), format, std::forward<Args>(args)...);
+    }
+
+    // a row-major char grid, written out line by line
+    struct Grid
+    {
+        Grid(al::usize width, al::usize height, char fill)
+            : m_width{ width }
+            , m_height{ height }
+            , m_cells(width * height, fill)
+        {
+        }
+
+        char& operator[](al::usize x, al::usize y) { return m_cells[y * m_width + x]; }
+        char  operator[](al::usize x, al::usize y) const { return m_cells[y * m_width + x]; }
+
+        void write(std::string& out) const
+        {
+            out.reserve(out.size() + (m_width + 1) * m_height);
+            for (auto y = 0uz; y < m_height; ++y) {
+                out.append(m_cells.data() + y * m_width, m_width);
+                out.push_back('\n');
+            }
+        }
+
+        al::usize         m_width;
+        al::usize         m_height;
+        std::vector<char> m_cells;
+    };
+}
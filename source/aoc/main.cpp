@@ -1,115 +1,1082 @@
 #include "day/all.hpp"
+#include "util/environment.hpp"
+#include "util/json.hpp"
+#include "util/mapped_file.hpp"
+#include "util/stats.hpp"
 
 #include <CLI/CLI.hpp>
 #include <fmt/base.h>
 #include <fmt/color.h>
 
-using aoc::common::Day, aoc::common::Part, aoc::common::RunResult, aoc::common::BenchResult;
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <exception>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+
+using aoc::common::Day, aoc::common::Part, aoc::common::SessionResult, aoc::common::BenchResult,
+    aoc::common::BenchConfig, aoc::common::Measurement, aoc::common::BatchResult, aoc::common::SolveConfig,
+    aoc::common::ColdConfig, aoc::common::ColdRun;
 
 inline static auto DATA_DIR = std::filesystem::path{ "data" };
 
-template <Day D, std::invocable<const D&, const std::filesystem::path&, Part> Fn>
-bool run_impl(const D& day, const std::filesystem::path infile, Fn runner)
+// the output of a task is buffered and printed at once, so that concurrently running tasks don't interleave
+struct Report
 {
-    fmt::println(">>> [{}] {:<24.24}", D::id, D::name);
+    std::string                     m_text;
+    aoc::common::CpuTimer::Duration m_cpu_time = {};
+
+    template <typename... Args>
+    void println(fmt::format_string<Args...> format, Args&&... args)
+    {
+        fmt::format_to(std::back_inserter(m_text), format, std::forward<Args>(args)...);
+        m_text.push_back('\n');
+    }
+};
+
+// writes the recorded zones on the way out of main, whichever way that is
+struct TraceOutput
+{
+    std::filesystem::path m_path;
+
+    ~TraceOutput()
+    {
+        if (m_path.empty()) {
+            return;
+        } else if (aoc::util::write_chrome_trace(m_path)) {
+            fmt::println("trace written to {}", m_path.string());
+        } else {
+            fmt::println("can't write the trace to {}", m_path.string());
+        }
+    }
+};
+
+// stops the sampling and writes the collapsed stacks on the way out of main
+struct ProfileOutput
+{
+    std::filesystem::path                      m_path;
+    std::optional<aoc::util::SamplingProfiler> m_profiler;
+
+    ~ProfileOutput()
+    {
+        if (not m_profiler.has_value()) {
+            return;
+        }
+
+        m_profiler->stop();
+        if (m_profiler->write_collapsed(m_path)) {
+            auto dropped = m_profiler->dropped_count();
+            fmt::println("{} samples written to {}", m_profiler->sample_count(), m_path.string());
+            if (dropped > 0) {
+                fmt::println("note: {} samples dropped, the sample buffer was full", dropped);
+            }
+        } else {
+            fmt::println("can't write the profile to {}", m_path.string());
+        }
+    }
+};
+
+// a day whose parts are scheduled, they may still be running
+struct DayRun
+{
+    Report                           m_header;
+    bool                             m_success;
+    std::vector<std::future<Report>> m_parts;
+};
+
+// run on the pool if there is one, otherwise right away on the calling thread
+template <std::invocable Fn>
+std::future<Report> launch(aoc::util::ThreadPool* pool, Fn&& fn)
+{
+    if (pool != nullptr) {
+        return pool->submit(std::forward<Fn>(fn));
+    }
+
+    auto promise = std::promise<Report>{};
+    promise.set_value(fn());
+    return promise.get_future();
+}
+
+// only the header so far, or the failure if the input file doesn't exist
+template <Day D>
+DayRun begin_run(const std::filesystem::path& infile)
+{
+    auto run = DayRun{ .m_header = {}, .m_success = true, .m_parts = {} };
+
+    run.m_header.println(">>> [{}] {:<24.24}", D::id, D::name);
     if (not std::filesystem::exists(infile)) {
-        fmt::println(
+        run.m_header.println(
             "\t{}: {} - {}\n",    //
             fmt::styled("FAILED", fmt::fg(fmt::color::red)),
             "input file not found",
             infile
         );
-        return false;
+        run.m_success = false;
+    }
+
+    return run;
+}
+
+// an exception thrown by `fn` ends up in the report instead
+template <std::invocable<Report&> Fn>
+Report guarded(Fn&& fn)
+{
+    auto report = Report{};
+    auto timer  = aoc::common::CpuTimer{};
+
+    try {
+        fn(report);
+    } catch (std::exception& e) {
+        report.println(
+            "\t{}: exception thrown - {}\n",    //
+            fmt::styled("FAILED", fmt::fg(fmt::color::red)),
+            e.what()
+        );
+    }
+
+    report.m_cpu_time = timer.elapsed();
+    return report;
+}
+
+// each part is a task of its own
+template <Day D, std::invocable<const D&, const std::filesystem::path&, Part, Report&> Fn>
+DayRun run_impl(const D& day, const std::filesystem::path infile, aoc::util::ThreadPool* pool, Fn runner)
+{
+    auto run = begin_run<D>(infile);
+    if (not run.m_success) {
+        return run;
     }
 
     for (auto part : { Part::One, Part::Two }) {
-        try {
-            runner(day, infile, part);
-        } catch (std::exception& e) {
-            fmt::println(
+        run.m_parts.push_back(launch(pool, [=] {
+            return guarded([&](Report& report) { runner(day, infile, part, report); });
+        }));
+    }
+
+    return run;
+}
+
+// wait for the parts then print the whole day, returns the summed cpu time of the parts
+aoc::common::CpuTimer::Duration finish(DayRun& run)
+{
+    auto cpu_time = aoc::common::CpuTimer::Duration{};
+
+    fmt::print("{}", run.m_header.m_text);
+    for (auto& part : run.m_parts) {
+        auto report  = part.get();
+        cpu_time    += report.m_cpu_time;
+        fmt::print("{}", report.m_text);
+    }
+
+    return cpu_time;
+}
+
+// empty if allocation tracking is not compiled in
+std::string format_allocs(const aoc::util::AllocStats& allocs)
+{
+    if constexpr (not aoc::util::alloc_tracking) {
+        return {};
+    } else {
+        return fmt::format(" [{} allocs, {} B, peak {} B]", allocs.m_count, allocs.m_bytes, allocs.m_peak);
+    }
+}
+
+std::string describe(std::exception_ptr error)
+{
+    try {
+        std::rethrow_exception(error);
+    } catch (std::exception& e) {
+        return e.what();
+    } catch (...) {
+        return "unknown exception";
+    }
+}
+
+template <Day D>
+void print_session_result(Report& report, const SessionResult<D>& result)
+{
+    auto to_ms = aoc::common::to_ms<double>;
+    auto total = result.m_load_time + result.m_parse_time;
+
+    report.println("\t> input");
+    if (result.m_cached) {
+        report.println(
+            "\t  cached    : both results found in {}, nothing parsed nor solved",
+            to_ms(result.m_load_time)
+        );
+    } else if (result.m_streamed) {
+        report.println("\t  streamed  : read by each part on its own, load and parse are part of the solve");
+    } else {
+        report.println("\t  load time : {}{}", to_ms(result.m_load_time), format_allocs(result.m_load_allocs));
+        report.println(
+            "\t  parse time: {}{}{}",
+            to_ms(result.m_parse_time),
+            format_allocs(result.m_parse_allocs),
+            result.m_snapshot ? " (read from the snapshot)" : ""
+        );
+    }
+
+    auto print_part = [&](Part part, const SessionResult<D>::Outcome& outcome) {
+        report.println("\t> part {}", std::to_underlying(part));
+        if (not outcome.has_value()) {
+            report.println(
                 "\t{}: exception thrown - {}\n",    //
                 fmt::styled("FAILED", fmt::fg(fmt::color::red)),
-                e.what()
+                describe(outcome.error())
             );
+            return;
         }
+
+        const auto& [output, solve_time, solve_allocs] = *outcome;
+
+        total += solve_time;
+        if (result.m_cached) {
+            report.println("\t  solve time: from the cache");
+        } else if (result.m_combined and part == Part::Two) {
+            report.println("\t  solve time: solved together with part 1");
+        } else {
+            report.println("\t  solve time: {}{}", to_ms(solve_time), format_allocs(solve_allocs));
+        }
+        report.println("\t  result    : {}", aoc::common::display(output));
+    };
+
+    print_part(Part::One, result.m_part_one);
+    print_part(Part::Two, result.m_part_two);
+
+    report.println("\t> total time: {}\n", to_ms(total));
+}
+
+// the whole day is a single task, the input is loaded and parsed once for both parts; on a pool the parts of a day
+// that solves them apart then run side by side (see common::run_session)
+template <Day D>
+DayRun session_impl(
+    const D&                    day,
+    const std::filesystem::path infile,
+    aoc::util::ThreadPool*      pool,
+    const SolveConfig&          solve_config
+)
+{
+    auto run = begin_run<D>(infile);
+    if (not run.m_success) {
+        return run;
     }
 
-    return true;
+    run.m_parts.push_back(launch(pool, [=] {
+        return guarded([&](Report& report) {
+            print_session_result(report, aoc::common::run_session(day, infile, solve_config, pool));
+        });
+    }));
+
+    return run;
 }
 
 template <Day D>
-bool run(const D& day)
+DayRun run(const D& day, aoc::util::ThreadPool* pool, const SolveConfig& solve_config)
 {
-    auto to_ms  = aoc::common::to_ms<double>;
     auto infile = DATA_DIR / "inputs" / D::id;
     infile.replace_extension(".txt");
 
-    return run_impl(day, infile, [&](const D& day, const std::filesystem::path& infile, Part part) {
-        fmt::println("\t> part {}", std::to_underlying(part));
+    return session_impl(day, infile, pool, solve_config);
+}
+
+void print_measurement(Report& report, std::string_view name, const Measurement& measurement)
+{
+    auto to_ms = aoc::common::to_ms<double>;
+
+    const auto& stats = measurement.m_stats;
+
+    report.println("\t  {}: {} (mean)", name, to_ms(stats.m_mean));
+    report.println(
+        "\t              min {} | median {} | p90 {} | p99 {}",
+        to_ms(stats.m_min),
+        to_ms(stats.m_median),
+        to_ms(stats.m_p90),
+        to_ms(stats.m_p99)
+    );
+    report.println(
+        "\t              stddev {} | mad {} | outliers {}/{}",
+        to_ms(stats.m_stddev),
+        to_ms(stats.m_mad),
+        stats.m_outliers.size(),
+        measurement.m_samples.size()
+    );
+
+    auto ci = measurement.m_ci.transform([](double ci) {
+        return fmt::format(" | median ±{:.2f}% (95% ci)", ci * 100.0);
+    });
+    report.println(
+        "\t              {} iterations after {} warm-up{}",
+        measurement.m_samples.size(),
+        measurement.m_warmup,
+        ci.value_or("")
+    );
+
+    if constexpr (aoc::util::alloc_tracking) {
+        const auto& allocs = measurement.m_allocs;
+        report.println(
+            "\t              allocs {} | bytes {} | peak {} B (per iteration)",
+            allocs.m_count,
+            allocs.m_bytes,
+            allocs.m_peak
+        );
+    }
+
+    if (not measurement.m_counters) {
+        return;
+    }
+
+    const auto& counts = *measurement.m_counters;
+    auto        count  = [](std::optional<double> value) {
+        return value.transform([](double v) { return fmt::format("{:.4g}", v); }).value_or("n/a");
+    };
+
+    report.println(
+        "\t              cycles {} | instructions {} | ipc {}",
+        count(counts.m_cycles),
+        count(counts.m_instructions),
+        count(counts.ipc())
+    );
+    report.println(
+        "\t              l1d miss {} | llc miss {} | branch miss {} | dtlb miss {}",
+        count(counts.m_l1d_misses),
+        count(counts.m_llc_misses),
+        count(counts.m_branch_misses),
+        count(counts.m_dtlb_misses)
+    );
+}
+
+// a benchmarked part, as it goes into the machine-readable output and the comparison with a baseline
+struct BenchRecord
+{
+    std::string_view           m_id;
+    std::string_view           m_name;
+    Part                       m_part;
+    std::optional<BenchResult> m_result;    // std::nullopt if it failed
+    std::string                m_error;
+};
+
+// collected from every task, in whatever order they finish
+struct BenchLog
+{
+    std::mutex               m_mutex;
+    std::vector<BenchRecord> m_records;
+
+    void add(BenchRecord record)
+    {
+        auto lock = std::unique_lock{ m_mutex };
+        m_records.push_back(std::move(record));
+    }
+
+    // by day then part
+    std::vector<BenchRecord> take()
+    {
+        auto lock    = std::unique_lock{ m_mutex };
+        auto records = std::move(m_records);
+        std::ranges::sort(records, {}, [](const BenchRecord& r) { return std::pair{ r.m_id, r.m_part }; });
+        return records;
+    }
+};
 
-        RunResult result = aoc::common::run_solution(std::move(day), infile, part);
+enum class Format
+{
+    Text,
+    Json,
+    Csv,
+};
 
-        fmt::println("\t  parse time: {}", to_ms(result.m_parse_time));
-        fmt::println("\t  solve time: {}", to_ms(result.m_solve_time));
-        fmt::println("\t  total time: {}", to_ms(result.m_parse_time + result.m_solve_time));
-        fmt::println("\t  result    : {}\n", aoc::common::display(result.m_result));
+// the phases of a bench result by name, in the order they run
+std::array<std::pair<std::string_view, const Measurement*>, 4> bench_phases(const BenchResult& result)
+{
+    return { {
+        { "load", &result.m_load },
+        { "parse", &result.m_parse },
+        { "copy", &result.m_copy },
+        { "solve", &result.m_solve },
+    } };
+}
+
+aoc::util::Json measurement_json(const Measurement& measurement)
+{
+    using Json = aoc::util::Json;
+
+    auto ns = [](aoc::common::Timer::Duration duration) { return Json{ duration.count() }; };
+
+    auto samples = Json::Array{};
+    samples.reserve(measurement.m_samples.size());
+    for (auto sample : measurement.m_samples) {
+        samples.push_back(ns(sample));
+    }
+
+    const auto& stats = measurement.m_stats;
+
+    auto counters = measurement.m_counters.transform([](const aoc::util::PerfCounts& counts) {
+        return Json{ Json::Object{
+            { "cycles", counts.m_cycles },
+            { "instructions", counts.m_instructions },
+            { "l1d_misses", counts.m_l1d_misses },
+            { "llc_misses", counts.m_llc_misses },
+            { "branch_misses", counts.m_branch_misses },
+            { "dtlb_misses", counts.m_dtlb_misses },
+        } };
     });
+
+    auto allocs = Json{};
+    if constexpr (aoc::util::alloc_tracking) {
+        allocs = Json::Object{
+            { "count", measurement.m_allocs.m_count },
+            { "bytes", measurement.m_allocs.m_bytes },
+            { "peak", measurement.m_allocs.m_peak },
+        };
+    }
+
+    return Json::Object{
+        { "samples_ns", std::move(samples) },
+        { "warmup", measurement.m_warmup },
+        { "ci", measurement.m_ci },
+        {
+            "stats_ns",
+            Json::Object{
+                { "min", ns(stats.m_min) },
+                { "max", ns(stats.m_max) },
+                { "mean", ns(stats.m_mean) },
+                { "median", ns(stats.m_median) },
+                { "p90", ns(stats.m_p90) },
+                { "p99", ns(stats.m_p99) },
+                { "stddev", ns(stats.m_stddev) },
+                { "mad", ns(stats.m_mad) },
+                { "outliers", stats.m_outliers.size() },
+            },
+        },
+        { "counters", counters.value_or(Json{}) },
+        { "allocs", std::move(allocs) },
+    };
+}
+
+std::string bench_json(
+    std::span<const BenchRecord>                 records,
+    const aoc::util::Environment&                env,
+    aoc::util::ClockSource                       clock,
+    const std::optional<aoc::util::StableSetup>& stable
+)
+{
+    using Json = aoc::util::Json;
+
+    auto results = Json::Array{};
+    for (const auto& [id, name, part, result, error] : records) {
+        auto phases = Json::Object{};
+        if (result.has_value()) {
+            for (auto [phase, measurement] : bench_phases(*result)) {
+                phases.emplace_back(phase, measurement_json(*measurement));
+            }
+        }
+
+        results.push_back(Json::Object{
+            { "day", id },
+            { "name", name },
+            { "part", std::to_underlying(part) },
+            { "error", result.has_value() ? Json{} : Json{ error } },
+            { "snapshot", result.has_value() and result->m_snapshot },
+            { "phases", std::move(phases) },
+        });
+    }
+
+    auto stable_json = Json{};
+    if (stable.has_value()) {
+        stable_json = Json::Object{
+            { "cpu", stable->m_cpu },
+            { "nice", stable->m_nice },
+            { "warnings", Json::Array(stable->m_warnings.begin(), stable->m_warnings.end()) },
+        };
+    }
+
+    auto document = Json::Object{
+        { "revision", env.m_revision },
+        {
+            "environment",
+            Json::Object{
+                { "cpu", env.m_cpu },
+                { "cpus", env.m_cpus },
+                { "kernel", env.m_kernel },
+                { "compiler", env.m_compiler },
+                { "build", env.m_build },
+            },
+        },
+        { "timer", clock == aoc::util::ClockSource::Tsc ? "tsc" : "chrono" },
+        { "stable", std::move(stable_json) },
+        { "results", std::move(results) },
+    };
+
+    return Json{ std::move(document) }.dump();
+}
+
+// one row per phase of every part (a failed part gets a single row with its error), the samples of a phase are
+// in a single field separated by spaces
+std::string bench_csv(std::span<const BenchRecord> records, const aoc::util::Environment& env)
+{
+    auto quote = [](std::string_view field) {
+        auto out = std::string{ "\"" };
+        for (auto c : field) {
+            out += c == '"' ? "\"\"" : std::string(1, c);
+        }
+        return out + '"';
+    };
+    auto count = [](std::optional<double> value) {
+        return value.transform([](double v) { return fmt::format("{}", v); }).value_or("");
+    };
+
+    auto out = std::string{
+        "day,name,part,phase,error,warmup,iterations,ci,min_ns,median_ns,mean_ns,p90_ns,p99_ns,max_ns,stddev_ns,"
+        "mad_ns,outliers,cycles,instructions,l1d_misses,llc_misses,branch_misses,dtlb_misses,revision,cpu,"
+        "samples_ns\n"
+    };
+
+    for (const auto& [id, name, part, result, error] : records) {
+        auto prefix = fmt::format("{},{},{}", id, quote(name), std::to_underlying(part));
+        if (not result.has_value()) {
+            fmt::format_to(std::back_inserter(out), "{},,{}{}\n", prefix, quote(error), std::string(21, ','));
+            continue;
+        }
+
+        for (auto [phase, measurement] : bench_phases(*result)) {
+            const auto& stats  = measurement->m_stats;
+            const auto  counts = measurement->m_counters.value_or(aoc::util::PerfCounts{});
+
+            auto samples = std::string{};
+            for (auto sample : measurement->m_samples) {
+                fmt::format_to(std::back_inserter(samples), "{}{}", samples.empty() ? "" : " ", sample.count());
+            }
+
+            fmt::format_to(
+                std::back_inserter(out),
+                "{},{},,{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{}\n",
+                prefix,
+                phase,
+                measurement->m_warmup,
+                measurement->m_samples.size(),
+                count(measurement->m_ci),
+                stats.m_min.count(),
+                stats.m_median.count(),
+                stats.m_mean.count(),
+                stats.m_p90.count(),
+                stats.m_p99.count(),
+                stats.m_max.count(),
+                stats.m_stddev.count(),
+                stats.m_mad.count(),
+                stats.m_outliers.size(),
+                count(counts.m_cycles),
+                count(counts.m_instructions),
+                count(counts.m_l1d_misses),
+                count(counts.m_llc_misses),
+                count(counts.m_branch_misses),
+                count(counts.m_dtlb_misses),
+                quote(env.m_revision),
+                quote(env.m_cpu),
+                samples
+            );
+        }
+    }
+
+    return out;
+}
+
+inline constexpr auto regression_alpha = 0.05;
+
+// compares the medians of the load, parse and solve phases of every part with those in a record written by
+// --format json (copy is left out, it's not part of a solution). a phase regresses when its median is more than
+// `threshold` slower and a one-sided mann-whitney u test on the samples says so with p < regression_alpha.
+// returns std::nullopt if the baseline can't be read, else whether anything regressed
+std::optional<bool> compare_with_baseline(
+    std::span<const BenchRecord> records,
+    const std::filesystem::path& path,
+    double                       threshold
+)
+{
+    using Json = aoc::util::Json;
+
+    auto file     = aoc::util::MappedFile::map(path);
+    auto baseline = file.has_value() ? Json::parse(file->view()) : std::nullopt;
+    if (not baseline or baseline->find("results") == nullptr or baseline->find("results")->array() == nullptr) {
+        return std::nullopt;
+    }
+
+    auto baseline_samples = [&](std::string_view id, Part part, std::string_view phase) {
+        auto samples = std::vector<double>{};
+        for (const auto& result : *baseline->find("results")->array()) {
+            const auto* day   = result.find("day");
+            const auto* num   = result.find("part");
+            const auto* found = result.find("phases");
+            found             = found != nullptr ? found->find(phase) : nullptr;
+            found             = found != nullptr ? found->find("samples_ns") : nullptr;
+
+            auto matches = day != nullptr and day->string() != nullptr and *day->string() == id and num != nullptr
+                       and num->number() == static_cast<double>(std::to_underlying(part));
+            if (matches and found != nullptr and found->array() != nullptr) {
+                for (const auto& sample : *found->array()) {
+                    samples.push_back(sample.number().value_or(0.0));
+                }
+            }
+        }
+        return samples;
+    };
+
+    const auto* revision = baseline->find("revision");
+    fmt::println(
+        ">>> compared with {} (revision {}), a phase regresses past +{}% at p < {}",
+        path.string(),
+        revision != nullptr and revision->string() != nullptr ? *revision->string() : "unknown",
+        threshold * 100.0,
+        regression_alpha
+    );
+
+    auto regressed = false;
+    for (const auto& [id, name, part, result, error] : records) {
+        if (not result.has_value()) {
+            continue;
+        }
+
+        for (auto [phase, measurement] : bench_phases(*result)) {
+            if (phase == "copy") {
+                continue;
+            }
+
+            auto label = fmt::format("[{}] part {} {:<5}", id, std::to_underlying(part), phase);
+            auto base  = baseline_samples(id, part, phase);
+            if (base.empty()) {
+                fmt::println("\t{}: not in the baseline", label);
+                continue;
+            }
+
+            auto current = std::vector<double>{};
+            for (auto sample : measurement->m_samples) {
+                current.push_back(static_cast<double>(sample.count()));
+            }
+
+            auto before = aoc::util::median_of(base);
+            auto after  = aoc::util::median_of(current);
+            auto delta  = before > 0.0 ? (after - before) / before : 0.0;
+            auto p      = aoc::util::mann_whitney_greater(current, base);
+            auto worse  = delta > threshold and p < regression_alpha;
+
+            regressed = regressed or worse;
+            fmt::println(
+                "\t{}: {:.4f} ms -> {:.4f} ms ({:+.2f}%, p {:.3g}){}",
+                label,
+                before / 1e6,
+                after / 1e6,
+                delta * 100.0,
+                p,
+                worse ? fmt::format(" {}", fmt::styled("REGRESSED", fmt::fg(fmt::color::red))) : ""
+            );
+        }
+    }
+
+    return regressed;
 }
 
 template <Day D>
-bool bench(const D& day, std::size_t repeat)
+DayRun bench(
+    const D&               day,
+    const BenchConfig&     config,
+    aoc::util::ThreadPool* pool,
+    const SolveConfig&     solve_config,
+    BenchLog*              log
+)
 {
-    auto to_ms  = aoc::common::to_ms<double>;
     auto infile = DATA_DIR / "inputs" / D::id;
     infile.replace_extension(".txt");
 
-    return run_impl(day, infile, [&](const D& day, const std::filesystem::path& infile, Part part) {
-        fmt::println("\t> part {}", std::to_underlying(part));
+    auto runner = [=](const D& day, const std::filesystem::path& infile, Part part, Report& report) {
+        auto to_ms = aoc::common::to_ms<double>;
 
-        BenchResult result = aoc::common::bench_solution(std::move(day), infile, part, repeat);
+        report.println("\t> part {}", std::to_underlying(part));
 
-        fmt::println("\t  parse time: {}", to_ms(result.m_parse_time));
-        fmt::println("\t  solve time: {}", to_ms(result.m_solve_time));
-        fmt::println("\t  total time: {}\n", to_ms(result.m_parse_time + result.m_solve_time));
-    });
+        auto result = std::optional<BenchResult>{};
+        try {
+            result = aoc::common::bench_solution(day, infile, part, config, solve_config);
+        } catch (std::exception& e) {
+            log->add({ .m_id = D::id, .m_name = D::name, .m_part = part, .m_result = {}, .m_error = e.what() });
+            throw;
+        }
+        log->add({ .m_id = D::id, .m_name = D::name, .m_part = part, .m_result = result, .m_error = {} });
+
+        const auto& [load, parse, copy, solve, snapshot] = *result;
+        auto total = load.m_stats.m_mean + parse.m_stats.m_mean + solve.m_stats.m_mean;
+
+        print_measurement(report, "load time ", load);
+        print_measurement(report, "parse time", parse);
+        if (snapshot) {
+            report.println("\t  (the input was read from its snapshot instead of parsed)");
+        }
+        print_measurement(report, "copy time ", copy);
+        print_measurement(report, "solve time", solve);
+        report.println("\t  total time: {} (mean, without copy)\n", to_ms(total));
+    };
+
+    return run_impl(day, infile, pool, runner);
+}
+
+template <Day D>
+DayRun sweep(
+    const D&               day,
+    const BenchConfig&     config,
+    std::size_t            steps,
+    aoc::util::ThreadPool* pool,
+    const SolveConfig&     solve_config
+)
+{
+    auto infile = DATA_DIR / "inputs" / D::id;
+    infile.replace_extension(".txt");
+
+    if constexpr (not aoc::common::Sweepable<D>) {
+        auto run = begin_run<D>(infile);
+        if (run.m_success) {
+            run.m_header.println("\t> no sweep for this day, its input can't be cut down\n");
+        }
+        return run;
+    } else {
+        auto runner = [=](const D& day, const std::filesystem::path& infile, Part part, Report& report) {
+            auto to_ms = aoc::common::to_ms<double>;
+
+            report.println("\t> part {}", std::to_underlying(part));
+
+            auto result = aoc::common::sweep_solution(day, infile, part, steps, config, solve_config);
+            auto unit   = result.m_shape == aoc::common::InputShape::Lines ? "lines" : "cells";
+
+            for (const auto& [size, solve] : result.m_points) {
+                auto ci = solve.m_ci.transform([](double ci) { return fmt::format(" ±{:.2f}%", ci * 100.0); });
+                auto median = to_ms(solve.m_stats.m_median);
+                report.println("\t  {:>9} {}: {} (median){}", size, unit, median, ci.value_or(""));
+            }
+
+            if (result.m_points.size() < 3) {
+                report.println("\t  too few distinct sizes to fit, the input is too small\n");
+                return;
+            }
+
+            // the coefficient is per unit of the model, the term of the notation without the O()
+            auto describe = [](const aoc::util::ComplexityFit& fit) {
+                auto notation = aoc::util::complexity_notation(fit.m_complexity);
+                auto term     = notation.substr(2, notation.size() - 3);
+                auto error    = fit.m_error * 100.0;
+                auto scale    = fit.m_coefficient;
+                return fmt::format("{} ~ {:.4g} ns * {} (error {:.1f}%)", notation, scale, term, error);
+            };
+            report.println("\t  best fit: {}", describe(result.m_fits[0]));
+            report.println("\t  then   : {}\n", describe(result.m_fits[1]));
+        };
+
+        return run_impl(day, infile, pool, runner);
+    }
 }
 
 template <Day D>
-bool test(const D& day)
+DayRun test(const D& day, aoc::util::ThreadPool* pool, const SolveConfig& solve_config)
 {
-    auto to_ms  = aoc::common::to_ms<double>;
     auto infile = DATA_DIR / "examples" / D::id;
     infile.replace_extension(".txt");
 
-    return run_impl(day, infile, [&](const D& day, const std::filesystem::path& infile, Part part) {
-        fmt::println("\t> part {}", std::to_underlying(part));
+    return session_impl(day, infile, pool, solve_config);
+}
+
+// one-shot runs of the day, each in a new process (see cold_child); `child_flags` are passed on to them
+template <Day D>
+DayRun cold(
+    const D&                        day,
+    const ColdConfig&               config,
+    const std::vector<std::string>& child_flags,
+    aoc::util::ThreadPool*          pool,
+    const SolveConfig&              solve_config
+)
+{
+    auto infile = DATA_DIR / "inputs" / D::id;
+    infile.replace_extension(".txt");
+
+    auto run = begin_run<D>(infile);
+    if (not run.m_success) {
+        return run;
+    }
+
+    auto args = std::vector<std::string>{ "aoc", D::id, "--cold-child" };
+    args.insert(args.end(), child_flags.begin(), child_flags.end());
+
+    run.m_parts.push_back(launch(pool, [=] {
+        return guarded([&](Report& report) {
+            auto to_ms  = aoc::common::to_ms<double>;
+            auto result = aoc::common::cold_solution(day, infile, config, "/proc/self/exe", args, solve_config);
+
+            auto print_run = [&](std::string_view name, const ColdRun& run, bool in_process) {
+                report.println(
+                    "\t  {}: process {} | load {} | parse {} | solve {}",
+                    name,
+                    in_process ? "-" : fmt::format("{}", to_ms(run.m_process)),
+                    to_ms(run.m_load),
+                    to_ms(run.m_parse),
+                    to_ms(run.m_solve)
+                );
+            };
+
+            const auto& stats = result.m_process;
+
+            auto in_session = [](const ColdRun& run) { return run.m_load + run.m_parse + run.m_solve; };
+            auto slowdown   = std::chrono::duration<double>{ in_session(result.m_first) }
+                          / std::chrono::duration<double>{ in_session(result.m_hot) };
+
+            report.println(
+                "\t> {} one-shot runs ({})",
+                config.m_runs,
+                config.m_evict ? "input evicted from the page cache, cpu caches flushed" : "page cache kept"
+            );
+            print_run("first     ", result.m_first, false);
+            print_run("steady    ", result.m_steady, false);
+            print_run("hot       ", result.m_hot, true);
+            report.println(
+                "\t  process   : min {} | median {} | p90 {} | max {} (steady runs)",
+                to_ms(stats.m_min),
+                to_ms(stats.m_median),
+                to_ms(stats.m_p90),
+                to_ms(stats.m_max)
+            );
+            report.println("\t  first/hot : {:.1f}x (load + parse + solve)\n", slowdown);
+        });
+    }));
+
+    return run;
+}
+
+// the process spawned by cold() for one of its runs, only the cold_report of its session goes to stdout
+template <Day D>
+int cold_child(const D& day, const SolveConfig& solve_config)
+{
+    auto infile = DATA_DIR / "inputs" / D::id;
+    infile.replace_extension(".txt");
+
+    auto result = aoc::common::run_session(day, infile, solve_config);
+    if (not result.m_part_one.has_value() or not result.m_part_two.has_value()) {
+        return EXIT_FAILURE;
+    }
+
+    fmt::print("{}", aoc::common::cold_report(result));
+    return EXIT_SUCCESS;
+}
+
+// parse the input once and write the snapshot of it next to it, later runs and benchmarks then read the input
+// from the snapshot instead of parsing it for as long as the snapshot is not older than the input
+template <Day D>
+DayRun snapshot(const D& day, aoc::util::ThreadPool* pool)
+{
+    auto infile = DATA_DIR / "inputs" / D::id;
+    infile.replace_extension(".txt");
+
+    auto run = begin_run<D>(infile);
+    if (not run.m_success) {
+        return run;
+    }
+
+    if constexpr (aoc::common::Snapshotable<D>) {
+        run.m_parts.push_back(launch(pool, [=] {
+            return guarded([&](Report& report) {
+                auto [path, size] = aoc::common::write_snapshot(day, infile);
+                report.println("\t> snapshot {} ({} bytes)\n", path, size);
+            });
+        }));
+    } else {
+        run.m_header.println("\t> no snapshot for this day, its input is always parsed\n");
+    }
 
-        RunResult result = aoc::common::run_solution(std::move(day), infile, part);
+    return run;
+}
 
-        fmt::println("\t  parse time: {}", to_ms(result.m_parse_time));
-        fmt::println("\t  solve time: {}", to_ms(result.m_solve_time));
-        fmt::println("\t  total time: {}", to_ms(result.m_parse_time + result.m_solve_time));
-        fmt::println("\t  result    : {}\n", aoc::common::display(result.m_result));
+// a single part on the input piped to stdin, read as it comes without ever holding all of it; only for a part
+// that can be streamed
+template <Day D>
+bool stream_stdin(const D& day, Part part, const SolveConfig& solve_config)
+{
+    auto to_ms   = aoc::common::to_ms<double>;
+    auto success = false;
+
+    auto report = guarded([&](Report& report) {
+        report.println(">>> [{}] {:<24.24}", D::id, D::name);
+        report.println("\t> part {} (stdin)", std::to_underlying(part));
+
+        auto result = aoc::common::stream_fd_solution(day, STDIN_FILENO, part, solve_config);
+        if (not result.has_value()) {
+            throw std::runtime_error{ "this part can't be streamed, it needs the whole input" };
+        }
+
+        report.println("\t  solve time: {}{}", to_ms(result->m_solve_time), format_allocs(result->m_solve_allocs));
+        report.println("\t  result    : {}\n", aoc::common::display(result->m_result));
+        success = true;
     });
+
+    fmt::print("{}", report.m_text);
+    return success;
+}
+
+template <Day D>
+bool batch(
+    const D&                     day,
+    const std::filesystem::path& dir,
+    aoc::util::ThreadPool*       pool,
+    const SolveConfig&           solve_config
+)
+{
+    constexpr auto max_failures_shown = 10uz;
+
+    auto to_ms = aoc::common::to_ms<double>;
+
+    fmt::println(">>> [{}] {:<24.24}", D::id, D::name);
+    if (not std::filesystem::is_directory(dir)) {
+        fmt::println(
+            "\t{}: {} - {}\n",    //
+            fmt::styled("FAILED", fmt::fg(fmt::color::red)),
+            "batch directory not found",
+            dir
+        );
+        return false;
+    }
+
+    BatchResult result = aoc::common::batch_solution(day, dir, pool, solve_config);
+
+    const auto& stats     = result.m_stats;
+    auto        seconds   = std::chrono::duration<double>{ result.m_wall_time }.count();
+    auto        megabytes = static_cast<double>(result.m_bytes) / 1e6;
+
+    fmt::println("\t> batch {} ({} threads)", dir, pool != nullptr ? pool->size() : 1uz);
+    fmt::println("\t  inputs    : {} ({:.2f} MB) in {}", result.m_inputs, megabytes, to_ms(result.m_wall_time));
+    // nothing solved (an empty directory, every input failed) leaves no throughput or latency to speak of
+    if (result.m_inputs > 0 and seconds > 0.0) {
+        fmt::println(
+            "\t  throughput: {:.1f} inputs/s | {:.2f} MB/s",
+            static_cast<double>(result.m_inputs) / seconds,
+            megabytes / seconds
+        );
+        fmt::println(
+            "\t  latency   : min {} | median {} | p90 {} | p99 {} | max {}",
+            to_ms(stats.m_min),
+            to_ms(stats.m_median),
+            to_ms(stats.m_p90),
+            to_ms(stats.m_p99),
+            to_ms(stats.m_max)
+        );
+    }
+
+    if (not result.m_failures.empty()) {
+        fmt::println("\t  {}    : {}", fmt::styled("failed", fmt::fg(fmt::color::red)), result.m_failures.size());
+        for (const auto& [path, what] : result.m_failures | std::views::take(max_failures_shown)) {
+            fmt::println("\t\t{} - {}", path, what);
+        }
+    }
+    fmt::println("");
+
+    return result.m_failures.empty();
 }
 
 int main(int argc, char** argv)
 {
     auto app = CLI::App{ "AOC C++ solutions" };
 
-    auto selected_day = std::string{};
-    auto bench_repeat = 0uz;
-    auto should_test  = false;
+    auto selected_day    = std::string{};
+    auto bench_repeat    = 0uz;
+    auto should_test     = false;
+    auto counters        = false;
+    auto jobs            = 1uz;
+    auto threads         = 1uz;
+    auto huge_pages      = false;
+    auto batch_dir       = std::filesystem::path{};
+    auto cache_dir       = std::filesystem::path{};
+    auto should_snapshot = false;
+    auto cold_runs       = 0uz;
+    auto evict           = false;
+    auto cold_child_run  = false;
+    auto trace_path      = std::filesystem::path{};
+    auto profile_path    = std::filesystem::path{};
+    auto clock           = aoc::util::ClockSource::Chrono;
+    auto stable          = false;
+    auto target_ci       = 0.0;
+    auto budget          = 10.0;
+    auto format          = Format::Text;
+    auto baseline_path   = std::filesystem::path{};
+    auto threshold       = 5.0;
+    auto sweep_steps     = 0uz;
+    auto stdin_part      = 0;
 
     auto solutions = aoc::common::generate_solutions_ids<aoc::day::Days>();
     solutions.insert(solutions.begin(), "all");
 
+    auto clock_sources = std::map<std::string, aoc::util::ClockSource>{
+        { "chrono", aoc::util::ClockSource::Chrono },
+        { "tsc", aoc::util::ClockSource::Tsc },
+    };
+    auto formats = std::map<std::string, Format>{
+        { "text", Format::Text },
+        { "json", Format::Json },
+        { "csv", Format::Csv },
+    };
+
     app.add_option("day", selected_day, "which solution to run")
         ->transform(CLI::IsMember{ solutions })
         ->required(true);
     app.add_option("-b,--bench", bench_repeat, "benchmark the solution by running specified number of times")
         ->transform(CLI::Bound{ 3, 10000 });
     app.add_flag("-t,--test", should_test, "test the solution by using example data");
+    app.add_flag("--counters", counters, "collect hardware performance counters while benchmarking")
+        ->needs("--bench");
+    app.add_option("-j,--jobs", jobs, "run each (day, part) pair as a task on this many threads")
+        ->transform(CLI::Bound{ 1, 1024 });
+    app.add_option("--threads", threads, "let a single solve spread its work on this many threads")
+        ->transform(CLI::Bound{ 1, 1024 });
+    app.add_flag("--huge-pages", huge_pages, "back the scratch arena of the solutions with huge pages");
+    app.add_option("--batch", batch_dir, "solve both parts of every input file in the directory")
+        ->excludes("--bench", "--test");
+    app.add_option("--stdin", stdin_part, "solve this part (1 or 2) of a single day on the input piped to stdin")
+        ->check(CLI::Range(1, 2))
+        ->excludes("--bench", "--test", "--batch");
+    app.add_option("--cache", cache_dir, "look the results up in this directory before solving, store them after")
+        ->excludes("--bench", "--test", "--batch", "--stdin");
+    app.add_flag("--snapshot", should_snapshot, "snapshot the parsed input, later runs read it instead of parsing")
+        ->excludes("--bench", "--test", "--batch", "--cache", "--stdin");
+    app.add_option("--cold", cold_runs, "time this many one-shot runs, each a new process, against a hot run")
+        ->check(CLI::Range(2, 1000))
+        ->excludes("--bench", "--test", "--batch", "--cache", "--snapshot", "--stdin");
+    app.add_flag("--evict", evict, "evict the input from the page cache and flush the cpu caches before a cold run")
+        ->needs("--cold");
+    app.add_option("--trace", trace_path, "write the zones of the harness and the solutions as a Chrome trace");
+    app.add_option("--profile", profile_path, "write a sampling profile of the run as collapsed stacks")
+        ->excludes("--cold");
+    app.add_option("--timer", clock, "the time source of the benchmarks and the trace zones")
+        ->transform(CLI::CheckedTransformer{ clock_sources, CLI::ignore_case });
+    app.add_option("--ci", target_ci, "sample until the 95% ci of each median is within this many percent")
+        ->transform(CLI::Bound{ 0.01, 50.0 })
+        ->needs("--bench");
+    app.add_option("--budget", budget, "the time limit of a measurement of --ci, in seconds")
+        ->capture_default_str()
+        ->transform(CLI::Bound{ 0.1, 3600.0 })
+        ->needs("--ci");
+    app.add_flag("--stable", stable, "pin the benchmark to a cpu, raise its priority and check the cpu frequency")
+        ->needs("--bench")
+        ->excludes("--jobs");
+    app.add_option("--format", format, "write the bench record to stdout as json or csv, the report to stderr")
+        ->transform(CLI::CheckedTransformer{ formats, CLI::ignore_case })
+        ->needs("--bench");
+    app.add_option("--compare", baseline_path, "compare with a --format json record, fail on a regression")
+        ->check(CLI::ExistingFile)
+        ->needs("--bench");
+    app.add_option("--threshold", threshold, "the slowdown of a median past which --compare fails, in percent")
+        ->capture_default_str()
+        ->check(CLI::Range(0.0, 1000.0))
+        ->needs("--compare");
+    app.add_option("--sweep", sweep_steps, "benchmark the solve at this many input sizes and fit its complexity")
+        ->check(CLI::Range(3, 20))
+        ->needs("--bench")
+        ->excludes("--format", "--compare");
+    app.add_flag("--cold-child", cold_child_run, "internal: a single run spawned by --cold")->group("");
 
     if (argc <= 1) {
         fmt::print("{}", app.help());
@@ -123,24 +1090,224 @@ int main(int argc, char** argv)
         return 1;
     }
 
+    // the record is the only thing on stdout, everything meant for a human goes to stderr instead
+    auto* record_out = stdout;
+    if (format != Format::Text) {
+        std::fflush(stdout);
+        if (auto fd = ::dup(STDOUT_FILENO); fd >= 0 and ::dup2(STDERR_FILENO, STDOUT_FILENO) >= 0) {
+            record_out = ::fdopen(fd, "w");
+        }
+    }
+
+    if (clock == aoc::util::ClockSource::Tsc and not aoc::util::tsc_usable()) {
+        fmt::println("the time stamp counter is not usable here (no invariant tsc), timing with chrono");
+        clock = aoc::util::ClockSource::Chrono;
+    }
+
+    auto trace_output = TraceOutput{};
+    if (not trace_path.empty() and not aoc::util::tracing) {
+        fmt::println("tracing is not compiled in (configure with -DAOC_TRACING=ON), no trace written");
+    } else if (not trace_path.empty()) {
+        aoc::util::start_tracing(clock);
+        trace_output.m_path = trace_path;
+    }
+
+    auto profile_output = ProfileOutput{};
+    if (not profile_path.empty() and not aoc::util::profiling_supported) {
+        fmt::println("profiling is not compiled in (configure with -DAOC_PROFILING=ON), no profile written");
+    } else if (not profile_path.empty()) {
+        profile_output.m_path     = profile_path;
+        profile_output.m_profiler = aoc::util::SamplingProfiler::start();
+        if (not profile_output.m_profiler.has_value()) {
+            fmt::println("can't start the sampling profiler, no profile written");
+        }
+    }
+
+    auto budget_time  = std::chrono::duration<double>{ budget };
+    auto bench_config = BenchConfig{
+        .m_repeat    = bench_repeat,
+        .m_counters  = counters,
+        .m_clock     = clock,
+        .m_target_ci = target_ci / 100.0,
+        .m_budget    = std::chrono::duration_cast<aoc::common::Timer::Duration>(budget_time),
+    };
+
+    if (auto reason = std::string{}; counters and not aoc::util::PerfCounters::open(&reason)) {
+        fmt::println("hardware performance counters unavailable ({}), timing only", reason);
+        bench_config.m_counters = false;
+    }
+
+    // recorded in every bench report, a number is not comparable to another without it
+    auto env       = aoc::util::capture_environment();
+    auto bench_log = BenchLog{};
+    if (bench_repeat != 0) {
+        fmt::println("revision: {}", env.m_revision);
+        fmt::println("cpu     : {} ({} threads)", env.m_cpu, env.m_cpus);
+        fmt::println("kernel  : {}", env.m_kernel);
+        fmt::println("compiler: {}", env.m_compiler);
+        fmt::println("build   : {}", env.m_build);
+
+        auto overhead = aoc::common::Timer::overhead(clock);
+        auto name     = clock == aoc::util::ClockSource::Tsc ? "the tsc" : "chrono";
+        fmt::println("note: timing with {}, {} of timer overhead taken off every sample", name, overhead);
+    }
+
+    if (jobs > 1 and (bench_repeat != 0 or cold_runs != 0)) {
+        fmt::println("note: benchmarking on {} threads, the measurements will disturb each other", jobs);
+    }
+    if (jobs > 1 and aoc::util::alloc_tracking) {
+        fmt::println("note: the allocations are counted process-wide, with --jobs a day's counts include others'");
+    }
+    if (jobs > 1 and threads > 1 and bench_config.m_counters) {
+        fmt::println("note: the --threads workers are shared, with --jobs a day's counters include others' work");
+    }
+
+    // with a single job everything runs on the main thread as before, each day printed as soon as it's done
+    auto pool     = jobs > 1 ? std::make_unique<aoc::util::ThreadPool>(jobs) : nullptr;
+    auto pool_ptr = pool.get();
+
+    // the calling thread of a parallel solve takes part in the work as well, hence one less worker; shared by
+    // every task so --jobs and --threads together don't multiply the number of threads
+    auto workers      = threads > 1 ? std::make_unique<aoc::util::ThreadPool>(threads - 1) : nullptr;
+    auto solve_config = SolveConfig{ .m_workers = workers.get(), .m_huge_pages = huge_pages };
+
+    // after the workers are started, they would inherit the affinity otherwise
+    auto stable_setup = std::optional<aoc::util::StableSetup>{};
+    if (stable) {
+        const auto& setup = stable_setup.emplace(aoc::util::stabilize());
+        if (setup.m_cpu.has_value()) {
+            fmt::println("stable  : pinned to cpu {}, nice {}", *setup.m_cpu, setup.m_nice);
+        } else {
+            fmt::println("stable  : not pinned, nice {}", setup.m_nice);
+        }
+        for (const auto& warning : setup.m_warnings) {
+            fmt::println("warning: {}", warning);
+        }
+    }
+
+    // without a build id an entry of another binary can't be told apart, the cache is left off then
+    auto cache = std::optional<aoc::util::ResultCache>{};
+    if (not cache_dir.empty() and not aoc::util::ResultCache::build_id()) {
+        fmt::println("note: the running binary can't be identified, --cache is ignored");
+    } else if (not cache_dir.empty()) {
+        cache = aoc::util::ResultCache::open(cache_dir);
+        if (not cache) {
+            fmt::println("can't create cache directory '{}'", cache_dir.string());
+            return 1;
+        }
+        solve_config.m_cache = &*cache;
+    }
+
+    if (cold_child_run) {
+        auto variant = aoc::common::create_solution<aoc::day::Days>(selected_day).value();
+        return std::visit([&](auto&& d) { return cold_child(d, solve_config); }, variant);
+    }
+
+    // the children don't get a pool for --jobs, every one of them runs a single day anyway
+    auto cold_config = ColdConfig{ .m_runs = cold_runs, .m_evict = evict };
+    auto child_flags = std::vector<std::string>{ "--threads", std::to_string(threads) };
+    if (huge_pages) {
+        child_flags.emplace_back("--huge-pages");
+    }
+
+    if (stdin_part != 0) {
+        if (selected_day == "all") {
+            fmt::println("--stdin needs a single day");
+            return 1;
+        }
+
+        auto part    = stdin_part == 1 ? Part::One : Part::Two;
+        auto variant = aoc::common::create_solution<aoc::day::Days>(selected_day).value();
+        auto success = std::visit([&](auto&& d) { return stream_stdin(d, part, solve_config); }, variant);
+
+        return success ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    if (not batch_dir.empty()) {
+        if (selected_day == "all") {
+            fmt::println("--batch needs a single day");
+            return 1;
+        }
+
+        auto variant = aoc::common::create_solution<aoc::day::Days>(selected_day).value();
+        auto success = std::visit([&](auto&& d) { return batch(d, batch_dir, pool_ptr, solve_config); }, variant);
+
+        return success ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
     // clang-format off
     auto run_visitor = [&](auto&& d) {
-        if      (should_test)         return test(d);
-        else if (bench_repeat != 0uz) return bench(d, bench_repeat);
-        else                          return run(d);
+        if      (should_snapshot)     return snapshot(d, pool_ptr);
+        else if (cold_runs != 0uz)    return cold(d, cold_config, child_flags, pool_ptr, solve_config);
+        else if (should_test)         return test(d, pool_ptr, solve_config);
+        else if (sweep_steps != 0uz)  return sweep(d, bench_config, sweep_steps, pool_ptr, solve_config);
+        else if (bench_repeat != 0uz) return bench(d, bench_config, pool_ptr, solve_config, &bench_log);
+        else                          return run(d, pool_ptr, solve_config);
     };
     // clang-format on
 
+    auto exit_code = EXIT_SUCCESS;
     if (selected_day == "all") {
-        auto successes     = aoc::meta::for_each_tuple(aoc::day::Days{}, run_visitor);
+        auto makespan      = aoc::common::Timer{};
+        auto cpu_time      = aoc::common::CpuTimer::Duration{};
         auto success_count = 0;
-        aoc::meta::for_each_tuple(successes, [&](bool success) { success_count += success; });
+        auto task_count    = 0uz;
 
-        return static_cast<int>(std::tuple_size_v<aoc::day::Days>) - success_count;
+        auto runs = std::vector<DayRun>{};
+        aoc::meta::for_each_tuple(aoc::day::Days{}, [&](auto&& d) {
+            auto& run = runs.emplace_back(run_visitor(d));
+            if (pool_ptr == nullptr) {
+                cpu_time += finish(run);
+            }
+        });
+
+        for (auto& run : runs) {
+            if (pool_ptr != nullptr) {
+                cpu_time += finish(run);
+            }
+            success_count += run.m_success;
+            task_count    += run.m_parts.size();
+        }
+
+        auto to_ms = aoc::common::to_ms<double>;
+        fmt::println(
+            ">>> {} tasks on {} thread(s): makespan {} | cpu time {} (summed over tasks)",
+            task_count,
+            jobs,
+            to_ms(makespan.elapsed()),
+            to_ms(cpu_time)
+        );
+
+        exit_code = static_cast<int>(std::tuple_size_v<aoc::day::Days>) - success_count;
     } else {
         auto variant = aoc::common::create_solution<aoc::day::Days>(selected_day).value();
-        auto success = std::visit(run_visitor, variant);
+        auto run     = std::visit(run_visitor, variant);
+        finish(run);
 
-        return success ? EXIT_SUCCESS : EXIT_FAILURE;
+        exit_code = run.m_success ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    if (bench_repeat == 0) {
+        return exit_code;
+    }
+
+    auto records = bench_log.take();
+    if (format == Format::Json) {
+        fmt::println(record_out, "{}", bench_json(records, env, clock, stable_setup));
+    } else if (format == Format::Csv) {
+        fmt::print(record_out, "{}", bench_csv(records, env));
     }
+    std::fflush(record_out);
+
+    if (not baseline_path.empty()) {
+        auto regressed = compare_with_baseline(records, baseline_path, threshold / 100.0);
+        if (not regressed) {
+            fmt::println(stderr, "can't read a bench record from '{}'", baseline_path.string());
+            return EXIT_FAILURE;
+        } else if (*regressed) {
+            exit_code = std::max(exit_code, 1);
+        }
+    }
+
+    return exit_code;
 }
@@ -1,8 +1,23 @@
 #pragma once
 
+#include "util/alloc_tracker.hpp"
+#include "util/arena.hpp"
 #include "util/array2d.hpp"
+#include "util/cold.hpp"
 #include "util/coordinate.hpp"
+#include "util/environment.hpp"
 #include "util/hash.hpp"
 #include "util/iter2d.hpp"
+#include "util/json.hpp"
+#include "util/line_index.hpp"
+#include "util/line_reader.hpp"
+#include "util/mapped_file.hpp"
+#include "util/perf_counters.hpp"
+#include "util/profiler.hpp"
 #include "util/ranges.hpp"
+#include "util/result_cache.hpp"
+#include "util/snapshot.hpp"
 #include "util/split.hpp"
+#include "util/stats.hpp"
+#include "util/thread_pool.hpp"
+#include "util/trace.hpp"
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace aoc::util
+{
+    // the global operator new/delete are only replaced when the aoc target is configured with
+    // -DAOC_TRACK_ALLOCATIONS=ON (see alloc_tracker.cpp), otherwise every AllocStats is zero
+#if defined(AOC_TRACK_ALLOCATIONS)
+    inline constexpr auto alloc_tracking = true;
+#else
+    inline constexpr auto alloc_tracking = false;
+#endif
+
+    struct AllocStats
+    {
+        std::uint64_t m_count;    // number of allocations
+        std::uint64_t m_bytes;    // total bytes requested
+        std::uint64_t m_peak;     // peak live bytes, on top of what was already live when the phase started
+    };
+
+    namespace detail
+    {
+        // process-wide, so allocations of every thread are counted
+        struct AllocCounters
+        {
+            std::atomic<std::uint64_t> m_count = 0;
+            std::atomic<std::uint64_t> m_bytes = 0;
+            std::atomic<std::uint64_t> m_live  = 0;
+            std::atomic<std::uint64_t> m_peak  = 0;
+
+            void on_alloc(std::uint64_t requested, std::uint64_t usable) noexcept
+            {
+                m_count.fetch_add(1, std::memory_order_relaxed);
+                m_bytes.fetch_add(requested, std::memory_order_relaxed);
+
+                auto live = m_live.fetch_add(usable, std::memory_order_relaxed) + usable;
+                auto peak = m_peak.load(std::memory_order_relaxed);
+                while (live > peak and not m_peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) { }
+            }
+
+            void on_free(std::uint64_t usable) noexcept { m_live.fetch_sub(usable, std::memory_order_relaxed); }
+        };
+
+        inline constinit auto alloc_counters = AllocCounters{};
+    }
+
+    // measures the allocations from its construction up to stop(); phases are not expected to nest since the
+    // peak is reset on construction. the counters are process-wide, so scopes on several threads at once (days
+    // run concurrently with --jobs) count each other's allocations and reset each other's peak
+    class AllocScope
+    {
+    public:
+        AllocScope() noexcept
+            : m_count{ detail::alloc_counters.m_count.load(std::memory_order_relaxed) }
+            , m_bytes{ detail::alloc_counters.m_bytes.load(std::memory_order_relaxed) }
+            , m_live{ detail::alloc_counters.m_live.load(std::memory_order_relaxed) }
+        {
+            detail::alloc_counters.m_peak.store(m_live, std::memory_order_relaxed);
+        }
+
+        AllocStats stop() const noexcept
+        {
+            auto& counters = detail::alloc_counters;
+            auto  peak     = counters.m_peak.load(std::memory_order_relaxed);
+
+            return {
+                .m_count = counters.m_count.load(std::memory_order_relaxed) - m_count,
+                .m_bytes = counters.m_bytes.load(std::memory_order_relaxed) - m_bytes,
+                .m_peak  = peak > m_live ? peak - m_live : 0,
+            };
+        }
+
+    private:
+        std::uint64_t m_count;
+        std::uint64_t m_bytes;
+        std::uint64_t m_live;
+    };
+}
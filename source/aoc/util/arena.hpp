@@ -0,0 +1,142 @@
+#pragma once
+
+#include <sys/mman.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <utility>
+
+namespace aoc::util
+{
+    // monotonic arena that learns its size: whatever didn't fit in its own block during a round is taken from
+    // the heap, then on reset() the block grows to fit the whole round; so a repeated workload of the same
+    // shape (benchmark iterations) stops hitting the heap after the first round. not thread-safe
+    class Arena : public std::pmr::memory_resource
+    {
+    public:
+        static constexpr auto huge_page_size = 2uz << 20;
+
+        // with `huge_pages` the block is aligned and rounded up to 2 MiB and transparent huge pages are requested
+        // for it (a no-op if THP is disabled), worth it for solutions that touch big grids all over the place
+        explicit Arena(bool huge_pages = false) noexcept
+            : m_huge_pages{ huge_pages }
+            , m_monotonic{ std::in_place, &m_overflow }
+        {
+        }
+
+        Arena(Arena&&)            = delete;
+        Arena& operator=(Arena&&) = delete;
+
+        ~Arena() override
+        {
+            m_monotonic.reset();
+            unmap();
+        }
+
+        // everything allocated from the arena is gone after this
+        void reset()
+        {
+            m_monotonic.reset();
+
+            if (auto wanted = m_block_size + m_overflow.m_bytes; m_overflow.m_bytes > 0 and remap(wanted)) {
+                m_overflow.m_bytes = 0;
+            }
+
+            if (m_block != nullptr) {
+                m_monotonic.emplace(m_block, m_block_size, &m_overflow);
+            } else {
+                m_monotonic.emplace(&m_overflow);
+            }
+        }
+
+        std::size_t block_size() const noexcept { return m_block_size; }
+
+    private:
+        // heap fallback that remembers how much the block was short of
+        struct Overflow : std::pmr::memory_resource
+        {
+            void* do_allocate(std::size_t bytes, std::size_t align) override
+            {
+                m_bytes += bytes;
+                return std::pmr::new_delete_resource()->allocate(bytes, align);
+            }
+
+            void do_deallocate(void* ptr, std::size_t bytes, std::size_t align) override
+            {
+                std::pmr::new_delete_resource()->deallocate(ptr, bytes, align);
+            }
+
+            bool do_is_equal(const memory_resource& other) const noexcept override { return this == &other; }
+
+            std::size_t m_bytes = 0;
+        };
+
+        bool remap(std::size_t size) noexcept
+        {
+            unmap();
+
+            if (m_huge_pages) {
+                size = (size + huge_page_size - 1) / huge_page_size * huge_page_size;
+            }
+
+            // mmap only aligns to the base page, so a huge page block is mapped with a huge page of slack and the
+            // unaligned head and tail are unmapped; otherwise its ends would be left on base pages
+            auto  slack  = m_huge_pages ? huge_page_size : 0uz;
+            auto  mapped = size + slack;
+            auto* addr   = ::mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (addr == MAP_FAILED) {
+                return false;    // stays on the heap
+            }
+
+            if (m_huge_pages) {
+                auto start   = reinterpret_cast<std::uintptr_t>(addr);
+                auto aligned = (start + huge_page_size - 1) / huge_page_size * huge_page_size;
+                auto head    = aligned - start;
+
+                if (head > 0) {
+                    ::munmap(addr, head);
+                }
+                if (auto tail = slack - head; tail > 0) {
+                    ::munmap(reinterpret_cast<void*>(aligned + size), tail);
+                }
+
+                addr = reinterpret_cast<void*>(aligned);
+                ::madvise(addr, size, MADV_HUGEPAGE);
+            }
+
+            m_block      = addr;
+            m_block_size = size;
+
+            return true;
+        }
+
+        void unmap() noexcept
+        {
+            if (m_block != nullptr) {
+                ::munmap(m_block, m_block_size);
+            }
+            m_block      = nullptr;
+            m_block_size = 0;
+        }
+
+        void* do_allocate(std::size_t bytes, std::size_t align) override
+        {
+            return m_monotonic->allocate(bytes, align);
+        }
+
+        void do_deallocate(void* ptr, std::size_t bytes, std::size_t align) override
+        {
+            m_monotonic->deallocate(ptr, bytes, align);
+        }
+
+        bool do_is_equal(const memory_resource& other) const noexcept override { return this == &other; }
+
+        bool                                               m_huge_pages;
+        void*                                              m_block      = nullptr;
+        std::size_t                                        m_block_size = 0;
+        Overflow                                           m_overflow;
+        std::optional<std::pmr::monotonic_buffer_resource> m_monotonic;    // last, it refers to the rest
+    };
+}
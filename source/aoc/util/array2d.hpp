@@ -3,17 +3,18 @@
 #include "common.hpp"
 #include "iter2d.hpp"
 
+#include <memory_resource>
 #include <vector>
 
 namespace aoc::util
 {
-    template <typename Elem>
+    template <typename Elem, typename Alloc = std::allocator<Elem>>
     struct Array2D
     {
-        Array2D(std::size_t width, std::size_t height, Elem default_val)
+        Array2D(std::size_t width, std::size_t height, Elem default_val, const Alloc& alloc = {})
             : m_width{ width }
             , m_height{ height }
-            , m_elems{ std::vector<Elem>(width * height, default_val) }
+            , m_elems(width * height, default_val, alloc)
         {
         }
 
@@ -44,9 +45,9 @@ namespace aoc::util
             return iter_2d_enumerate(std::forward<Self>(self).m_elems, self.m_width, self.m_height);
         }
 
-        std::size_t       m_width;
-        std::size_t       m_height;
-        std::vector<Elem> m_elems;
+        std::size_t              m_width;
+        std::size_t              m_height;
+        std::vector<Elem, Alloc> m_elems;
     };
 
     template <>
@@ -85,4 +86,11 @@ namespace aoc::util
         std::size_t       m_height;
         std::vector<bool> m_elems;
     };
+
+    namespace pmr
+    {
+        // not for bool, the std::vector<bool> specialization above only exists for the default allocator
+        template <typename Elem>
+        using Array2D = util::Array2D<Elem, std::pmr::polymorphic_allocator<Elem>>;
+    }
 }
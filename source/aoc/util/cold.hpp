@@ -0,0 +1,106 @@
+#pragma once
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <system_error>
+#include <vector>
+
+extern char** environ;
+
+namespace aoc::util
+{
+    // bigger than the last-level cache of anything this is going to run on
+    inline constexpr auto cache_flush_size = 256uz << 20;
+
+    struct ProcessResult
+    {
+        int         m_exit_code;    // -1 if it didn't exit normally
+        std::string m_output;       // its stdout, stderr is inherited
+    };
+
+    // drops the pages of the file from the page cache so the next read of it goes to the device; the pages must
+    // be clean (anything written since boot is unless it's still dirty), returns false if the file can't be opened
+    inline bool evict_page_cache(const std::filesystem::path& path) noexcept
+    {
+        auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        ::close(fd);
+        return true;
+    }
+
+    // there is no way to flush the cpu caches from user space, so they are filled with something else instead
+    inline void flush_cpu_caches()
+    {
+        auto buffer = std::vector<char>(cache_flush_size);
+
+        auto* data = static_cast<volatile char*>(buffer.data());
+        for (auto i = 0uz; i < buffer.size(); i += 64) {
+            data[i] = static_cast<char>(data[i] + 1);
+        }
+    }
+
+    // runs the executable at `path` with `args` (args[0] included) to completion and collects its stdout;
+    // throws std::system_error if it can't be started
+    inline ProcessResult run_process(const std::filesystem::path& path, std::span<const std::string> args)
+    {
+        auto argv = std::vector<char*>{};
+        for (const auto& arg : args) {
+            argv.push_back(const_cast<char*>(arg.c_str()));
+        }
+        argv.push_back(nullptr);
+
+        int pipe_fds[2];
+        if (::pipe2(pipe_fds, O_CLOEXEC) != 0) {
+            throw std::system_error{ errno, std::generic_category(), "pipe" };
+        }
+
+        // the write end is dup2-ed onto the stdout of the child, which clears its O_CLOEXEC there
+        auto actions = posix_spawn_file_actions_t{};
+        ::posix_spawn_file_actions_init(&actions);
+        ::posix_spawn_file_actions_adddup2(&actions, pipe_fds[1], STDOUT_FILENO);
+
+        auto pid = pid_t{};
+        auto err = ::posix_spawn(&pid, path.c_str(), &actions, nullptr, argv.data(), environ);
+
+        ::posix_spawn_file_actions_destroy(&actions);
+        ::close(pipe_fds[1]);
+
+        if (err != 0) {
+            ::close(pipe_fds[0]);
+            throw std::system_error{ err, std::generic_category(), path.string() };
+        }
+
+        auto result = ProcessResult{ .m_exit_code = -1, .m_output = {} };
+
+        char chunk[4096];
+        while (true) {
+            auto count = ::read(pipe_fds[0], chunk, sizeof(chunk));
+            if (count < 0 and errno == EINTR) {
+                continue;
+            } else if (count <= 0) {
+                break;
+            }
+            result.m_output.append(chunk, static_cast<std::size_t>(count));
+        }
+        ::close(pipe_fds[0]);
+
+        auto status = 0;
+        while (::waitpid(pid, &status, 0) < 0 and errno == EINTR) { }
+
+        if (WIFEXITED(status)) {
+            result.m_exit_code = WEXITSTATUS(status);
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/utsname.h>
+
+#include <fstream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// the flags the aoc target was compiled with and the revision it was built from, passed in by CMakeLists.txt
+#if not defined(AOC_BUILD_TYPE)
+#    define AOC_BUILD_TYPE "unknown"
+#endif
+#if not defined(AOC_BUILD_FLAGS)
+#    define AOC_BUILD_FLAGS "unknown"
+#endif
+#if not defined(AOC_GIT_REVISION)
+#    define AOC_GIT_REVISION "unknown"
+#endif
+
+namespace aoc::util
+{
+    // what a benchmark ran on, so numbers from different machines or builds can be told apart
+    struct Environment
+    {
+        std::string  m_cpu;         // model name
+        unsigned int m_cpus;        // hardware threads
+        std::string  m_kernel;      // sysname release version
+        std::string  m_compiler;
+        std::string  m_build;       // build type and compiler flags
+        std::string  m_revision;    // git describe of the source, as of the configure step
+    };
+
+    // what stabilize() managed to do, and what it found in the way of stable measurements
+    struct StableSetup
+    {
+        std::optional<int>       m_cpu;     // the calling thread is pinned to it
+        int                      m_nice;    // of the process after raising its priority, lower is higher
+        std::vector<std::string> m_warnings;
+    };
+
+    namespace detail
+    {
+        // the first line of the file, std::nullopt if it can't be read
+        inline std::optional<std::string> read_first_line(const std::string& path)
+        {
+            auto file = std::ifstream{ path };
+            auto line = std::string{};
+            if (not std::getline(file, line)) {
+                return std::nullopt;
+            }
+            return line;
+        }
+
+        inline std::string cpu_model()
+        {
+            auto file = std::ifstream{ "/proc/cpuinfo" };
+            for (auto line = std::string{}; std::getline(file, line);) {
+                // "model name" on x86, "CPU part" and the like elsewhere are not worth the trouble
+                if (line.starts_with("model name")) {
+                    auto colon = line.find(':');
+                    return colon == std::string::npos ? line : line.substr(line.find_first_not_of(' ', colon + 1));
+                }
+            }
+            return "unknown";
+        }
+    }
+
+    inline Environment capture_environment()
+    {
+        auto names  = ::utsname{};
+        auto kernel = ::uname(&names) == 0
+                        ? std::string{ names.sysname } + " " + names.release + " " + names.version
+                        : std::string{ "unknown" };
+
+#if defined(__clang__)
+        auto compiler = std::string{ "clang " } + __clang_version__;
+#elif defined(__GNUC__)
+        auto compiler = std::string{ "gcc " } + __VERSION__;
+#else
+        auto compiler = std::string{ "unknown" };
+#endif
+
+        return {
+            .m_cpu      = detail::cpu_model(),
+            .m_cpus     = std::thread::hardware_concurrency(),
+            .m_kernel   = std::move(kernel),
+            .m_compiler = std::move(compiler),
+            .m_build    = std::string{ AOC_BUILD_TYPE } + " " + AOC_BUILD_FLAGS,
+            .m_revision = AOC_GIT_REVISION,
+        };
+    }
+
+    // pins the calling thread to the cpu it's on, raises the priority of the process as far as it's permitted
+    // (the nice value, a real-time policy would starve the rest of the machine if a solution never returns) and
+    // checks the frequency scaling of that cpu; nothing here is fatal, what can't be done ends up in m_warnings
+    inline StableSetup stabilize()
+    {
+        auto setup = StableSetup{ .m_cpu = std::nullopt, .m_nice = 0, .m_warnings = {} };
+
+        auto cpu = ::sched_getcpu();
+        auto set = cpu_set_t{};
+        CPU_ZERO(&set);
+        if (cpu >= 0) {
+            CPU_SET(static_cast<std::size_t>(cpu), &set);
+        }
+
+        if (cpu >= 0 and ::sched_setaffinity(0, sizeof(set), &set) == 0) {
+            setup.m_cpu = cpu;
+        } else {
+            setup.m_warnings.emplace_back("can't pin the thread to a cpu, it may migrate during a measurement");
+        }
+
+        // the lowest nice value that is permitted, RLIMIT_NICE allows down to 20 - rlim_cur without privileges
+        for (auto nice = -20; nice <= 0; ++nice) {
+            if (::setpriority(PRIO_PROCESS, 0, nice) == 0) {
+                break;
+            }
+        }
+        setup.m_nice = ::getpriority(PRIO_PROCESS, 0);
+        if (setup.m_nice >= 0) {
+            setup.m_warnings.emplace_back("can't raise the priority (needs CAP_SYS_NICE or RLIMIT_NICE)");
+        }
+
+        auto cpufreq  = "/sys/devices/system/cpu/cpu" + std::to_string(cpu < 0 ? 0 : cpu) + "/cpufreq/";
+        auto governor = detail::read_first_line(cpufreq + "scaling_governor");
+        if (not governor) {
+            setup.m_warnings.emplace_back("no cpufreq here (a vm?), the governor and turbo can't be checked");
+            return setup;
+        } else if (*governor != "performance") {
+            setup.m_warnings.push_back("the cpufreq governor is '" + *governor + "', not 'performance'");
+        }
+
+        // intel_pstate has its own switch, acpi-cpufreq and amd-pstate the generic one
+        auto no_turbo = detail::read_first_line("/sys/devices/system/cpu/intel_pstate/no_turbo");
+        auto boost    = detail::read_first_line("/sys/devices/system/cpu/cpufreq/boost");
+        if (no_turbo == "0" or boost == "1") {
+            setup.m_warnings.emplace_back("turbo boost is on, the clock of the cpu depends on its temperature");
+        }
+
+        return setup;
+    }
+}
@@ -0,0 +1,359 @@
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace aoc::util
+{
+    // a json document, just enough of it to write the bench records and read them back: numbers are doubles
+    // (exact up to 2^53, which is plenty for nanoseconds) and an object keeps its keys in insertion order
+    class Json
+    {
+    public:
+        using Array  = std::vector<Json>;
+        using Object = std::vector<std::pair<std::string, Json>>;
+
+        Json() noexcept = default;
+
+        Json(std::nullptr_t) noexcept { }
+        Json(bool value) noexcept
+            : m_value{ value }
+        {
+        }
+        Json(double value) noexcept
+            : m_value{ value }
+        {
+        }
+        Json(std::string value) noexcept
+            : m_value{ std::move(value) }
+        {
+        }
+        Json(std::string_view value)
+            : m_value{ std::string{ value } }
+        {
+        }
+        Json(const char* value)
+            : m_value{ std::string{ value } }
+        {
+        }
+        Json(Array value) noexcept
+            : m_value{ std::move(value) }
+        {
+        }
+        Json(Object value) noexcept
+            : m_value{ std::move(value) }
+        {
+        }
+
+        template <typename T>
+            requires std::is_integral_v<T> and (not std::is_same_v<T, bool>)
+        Json(T value) noexcept
+            : m_value{ static_cast<double>(value) }
+        {
+        }
+
+        template <typename T>
+        Json(const std::optional<T>& value)
+            : Json{ value.has_value() ? Json{ *value } : Json{} }
+        {
+        }
+
+        bool is_null() const noexcept { return std::holds_alternative<std::nullptr_t>(m_value); }
+
+        // std::nullopt/nullptr if the value is of another type
+        std::optional<bool>   boolean() const noexcept { return get<bool>(); }
+        std::optional<double> number() const noexcept { return get<double>(); }
+        const std::string*    string() const noexcept { return std::get_if<std::string>(&m_value); }
+        const Array*          array() const noexcept { return std::get_if<Array>(&m_value); }
+        const Object*         object() const noexcept { return std::get_if<Object>(&m_value); }
+
+        // the value of `key` if this is an object that has it, nullptr otherwise
+        const Json* find(std::string_view key) const noexcept
+        {
+            if (const auto* members = object(); members != nullptr) {
+                for (const auto& [name, value] : *members) {
+                    if (name == key) {
+                        return &value;
+                    }
+                }
+            }
+            return nullptr;
+        }
+
+        // compact, on a single line; a number that is not finite is written as null
+        std::string dump() const
+        {
+            auto out = std::string{};
+            dump_into(out);
+            return out;
+        }
+
+        // std::nullopt if `text` is not a single json value (surrounded by whitespace at most)
+        static std::optional<Json> parse(std::string_view text)
+        {
+            auto parser = Parser{ text, 0 };
+            auto value  = parser.value(0);
+            parser.skip_space();
+            if (not value or parser.m_pos != text.size()) {
+                return std::nullopt;
+            }
+            return value;
+        }
+
+    private:
+        template <typename T>
+        std::optional<T> get() const noexcept
+        {
+            if (const auto* value = std::get_if<T>(&m_value); value != nullptr) {
+                return *value;
+            }
+            return std::nullopt;
+        }
+
+        static void dump_string(std::string& out, std::string_view str)
+        {
+            out.push_back('"');
+            for (auto c : str) {
+                switch (c) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        constexpr auto hex = std::string_view{ "0123456789abcdef" };
+                        out += "\\u00";
+                        out.push_back(hex[static_cast<unsigned char>(c) >> 4]);
+                        out.push_back(hex[static_cast<unsigned char>(c) & 0xf]);
+                    } else {
+                        out.push_back(c);
+                    }
+                }
+            }
+            out.push_back('"');
+        }
+
+        void dump_into(std::string& out) const
+        {
+            auto visitor = [&]<typename T>(const T& value) {
+                if constexpr (std::is_same_v<T, std::nullptr_t>) {
+                    out += "null";
+                } else if constexpr (std::is_same_v<T, bool>) {
+                    out += value ? "true" : "false";
+                } else if constexpr (std::is_same_v<T, double>) {
+                    if (not std::isfinite(value)) {
+                        out += "null";
+                        return;
+                    }
+                    auto buffer = std::array<char, 32>{};
+                    auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+                    out.append(buffer.data(), result.ptr);
+                } else if constexpr (std::is_same_v<T, std::string>) {
+                    dump_string(out, value);
+                } else if constexpr (std::is_same_v<T, Array>) {
+                    out.push_back('[');
+                    for (auto i = 0uz; i < value.size(); ++i) {
+                        out += i == 0 ? "" : ",";
+                        value[i].dump_into(out);
+                    }
+                    out.push_back(']');
+                } else {
+                    out.push_back('{');
+                    for (auto i = 0uz; i < value.size(); ++i) {
+                        out += i == 0 ? "" : ",";
+                        dump_string(out, value[i].first);
+                        out.push_back(':');
+                        value[i].second.dump_into(out);
+                    }
+                    out.push_back('}');
+                }
+            };
+            std::visit(visitor, m_value);
+        }
+
+        // recursive descent, nesting deeper than max_depth is rejected rather than overflowing the stack
+        struct Parser
+        {
+            static constexpr auto max_depth = 256;
+
+            std::string_view m_text;
+            std::size_t      m_pos;
+
+            void skip_space() noexcept
+            {
+                while (m_pos < m_text.size() and std::string_view{ " \t\r\n" }.contains(m_text[m_pos])) {
+                    ++m_pos;
+                }
+            }
+
+            bool consume(std::string_view token) noexcept
+            {
+                if (m_text.substr(m_pos).starts_with(token)) {
+                    m_pos += token.size();
+                    return true;
+                }
+                return false;
+            }
+
+            std::optional<Json> value(int depth)
+            {
+                skip_space();
+                if (depth > max_depth or m_pos >= m_text.size()) {
+                    return std::nullopt;
+                }
+
+                switch (m_text[m_pos]) {
+                case 'n': return consume("null") ? std::optional{ Json{} } : std::nullopt;
+                case 't': return consume("true") ? std::optional{ Json{ true } } : std::nullopt;
+                case 'f': return consume("false") ? std::optional{ Json{ false } } : std::nullopt;
+                case '"': return string().transform([](std::string str) { return Json{ std::move(str) }; });
+                case '[': return array(depth);
+                case '{': return object(depth);
+                default: return number();
+                }
+            }
+
+            std::optional<Json> number() noexcept
+            {
+                auto value  = 0.0;
+                auto first  = m_text.data() + m_pos;
+                auto result = std::from_chars(first, m_text.data() + m_text.size(), value);
+                if (result.ec != std::errc{} or result.ptr == first) {
+                    return std::nullopt;
+                }
+                m_pos += static_cast<std::size_t>(result.ptr - first);
+                return Json{ value };
+            }
+
+            std::optional<std::string> string()
+            {
+                if (not consume("\"")) {
+                    return std::nullopt;
+                }
+
+                auto out = std::string{};
+                while (m_pos < m_text.size()) {
+                    auto c = m_text[m_pos++];
+                    if (c == '"') {
+                        return out;
+                    } else if (c != '\\') {
+                        out.push_back(c);
+                        continue;
+                    } else if (m_pos >= m_text.size()) {
+                        return std::nullopt;
+                    }
+
+                    switch (auto escaped = m_text[m_pos++]) {
+                    case '"':
+                    case '\\':
+                    case '/': out.push_back(escaped); break;
+                    case 'b': out.push_back('\b'); break;
+                    case 'f': out.push_back('\f'); break;
+                    case 'n': out.push_back('\n'); break;
+                    case 'r': out.push_back('\r'); break;
+                    case 't': out.push_back('\t'); break;
+                    case 'u': {
+                        auto code = 0u;
+                        auto hex  = m_text.substr(m_pos, 4);
+                        auto end  = hex.data() + hex.size();
+                        if (hex.size() != 4 or std::from_chars(hex.data(), end, code, 16).ptr != end) {
+                            return std::nullopt;
+                        }
+                        m_pos += 4;
+                        append_utf8(out, code);    // surrogates are not paired up, nothing here writes them
+                        break;
+                    }
+                    default: return std::nullopt;
+                    }
+                }
+                return std::nullopt;
+            }
+
+            std::optional<Json> array(int depth)
+            {
+                consume("[");
+                auto values = Array{};
+
+                skip_space();
+                if (consume("]")) {
+                    return Json{ std::move(values) };
+                }
+
+                while (true) {
+                    auto value = this->value(depth + 1);
+                    if (not value) {
+                        return std::nullopt;
+                    }
+                    values.push_back(std::move(*value));
+
+                    skip_space();
+                    if (consume("]")) {
+                        return Json{ std::move(values) };
+                    } else if (not consume(",")) {
+                        return std::nullopt;
+                    }
+                }
+            }
+
+            std::optional<Json> object(int depth)
+            {
+                consume("{");
+                auto members = Object{};
+
+                skip_space();
+                if (consume("}")) {
+                    return Json{ std::move(members) };
+                }
+
+                while (true) {
+                    skip_space();
+                    auto key = string();
+                    skip_space();
+                    if (not key or not consume(":")) {
+                        return std::nullopt;
+                    }
+
+                    auto value = this->value(depth + 1);
+                    if (not value) {
+                        return std::nullopt;
+                    }
+                    members.emplace_back(std::move(*key), std::move(*value));
+
+                    skip_space();
+                    if (consume("}")) {
+                        return Json{ std::move(members) };
+                    } else if (not consume(",")) {
+                        return std::nullopt;
+                    }
+                }
+            }
+
+            static void append_utf8(std::string& out, unsigned int code)
+            {
+                if (code < 0x80) {
+                    out.push_back(static_cast<char>(code));
+                } else if (code < 0x800) {
+                    out.push_back(static_cast<char>(0xc0 | (code >> 6)));
+                    out.push_back(static_cast<char>(0x80 | (code & 0x3f)));
+                } else {
+                    out.push_back(static_cast<char>(0xe0 | (code >> 12)));
+                    out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3f)));
+                    out.push_back(static_cast<char>(0x80 | (code & 0x3f)));
+                }
+            }
+        };
+
+        std::variant<std::nullptr_t, bool, double, std::string, Array, Object> m_value;
+    };
+}
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#if defined(__x86_64__)
+#    include <immintrin.h>
+#endif
+
+namespace aoc::util
+{
+    namespace detail
+    {
+        // every kernel scans a block of this many bytes and returns a bitmask of the '\n' in it (bit i ~ byte i)
+        inline constexpr auto line_block_size = 64uz;
+
+        // SWAR fallback, 8 bytes at a time. exact: no false positive on bytes >= 0x80
+        inline std::uint64_t newline_mask_scalar(const char* block) noexcept
+        {
+            constexpr auto ones   = 0x0101010101010101ull;
+            constexpr auto low7   = 0x7f7f7f7f7f7f7f7full;
+            constexpr auto gather = 0x0102040810204080ull;    // moves bit 8k to bit 56 + k
+
+            auto mask = std::uint64_t{ 0 };
+            for (auto i = 0uz; i < line_block_size; i += 8) {
+                auto word = std::uint64_t{};
+                std::memcpy(&word, block + i, sizeof(word));
+                if constexpr (std::endian::native == std::endian::big) {
+                    word = std::byteswap(word);
+                }
+
+                auto eq    = word ^ (ones * '\n');                   // zero byte where '\n' is
+                auto hi    = ~(((eq & low7) + low7) | eq | low7);    // 0x80 on zero bytes only
+                auto bits  = ((hi >> 7) * gather) >> 56;
+                mask      |= bits << i;
+            }
+            return mask;
+        }
+
+#if defined(__x86_64__)
+        // SSE2 is part of the x86-64 baseline, no need for target attribute
+        [[gnu::always_inline]] inline std::uint64_t newline_mask_sse2(const char* block) noexcept
+        {
+            const auto nl = _mm_set1_epi8('\n');
+
+            auto mask = std::uint64_t{ 0 };
+            for (auto i = 0uz; i < line_block_size; i += 16) {
+                auto chunk  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+                auto bits   = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, nl)));
+                mask       |= std::uint64_t{ bits } << i;
+            }
+            return mask;
+        }
+
+        // not always_inline: it can't be inlined into the generic template, see index_lines_avx2 below
+        [[gnu::target("avx2")]] inline std::uint64_t newline_mask_avx2(const char* block) noexcept
+        {
+            const auto nl = _mm256_set1_epi8('\n');
+
+            auto lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+            auto hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+
+            auto lo_bits = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, nl)));
+            auto hi_bits = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, nl)));
+
+            return std::uint64_t{ lo_bits } | (std::uint64_t{ hi_bits } << 32);
+        }
+#endif
+
+        // call `fn(mask, offset)` for each block of the content, the last partial block is zero-padded
+        template <std::uint64_t (*Kernel)(const char*) noexcept, typename Fn>
+        [[gnu::always_inline]] inline void for_each_block(std::string_view content, Fn&& fn)
+        {
+            const auto* data = content.data();
+            const auto  size = content.size();
+
+            auto offset = 0uz;
+            for (; offset + line_block_size <= size; offset += line_block_size) {
+                fn(Kernel(data + offset), offset);
+            }
+
+            if (offset < size) {
+                char tail[line_block_size] = {};
+                std::memcpy(tail, data + offset, size - offset);
+                fn(Kernel(tail), offset);
+            }
+        }
+
+        template <std::uint64_t (*Kernel)(const char*) noexcept>
+        [[gnu::always_inline]] inline void index_lines_with(
+            std::string_view               content,
+            std::vector<std::string_view>& lines
+        )
+        {
+            // pre-pass: the number of lines is known exactly, so the output is allocated only once
+            auto newlines = 0uz;
+            for_each_block<Kernel>(content, [&](std::uint64_t mask, std::size_t) {
+                newlines += static_cast<std::size_t>(std::popcount(mask));
+            });
+            lines.reserve(lines.size() + newlines + 1);
+
+            const auto* data  = content.data();
+            auto        start = 0uz;
+
+            for_each_block<Kernel>(content, [&](std::uint64_t mask, std::size_t offset) {
+                while (mask != 0) {
+                    auto end = offset + static_cast<std::size_t>(std::countr_zero(mask));
+                    auto len = end - start;
+                    if (len > 0 and data[end - 1] == '\r') {
+                        --len;
+                    }
+                    lines.emplace_back(data + start, len);
+
+                    start  = end + 1;
+                    mask  &= mask - 1;
+                }
+            });
+
+            // same semantics as std::getline: no trailing empty line if the content ends with a new line
+            if (start < content.size()) {
+                auto len = content.size() - start;
+                if (data[content.size() - 1] == '\r') {
+                    --len;
+                }
+                lines.emplace_back(data + start, len);
+            }
+        }
+
+        inline void index_lines_scalar(std::string_view content, std::vector<std::string_view>& lines)
+        {
+            index_lines_with<newline_mask_scalar>(content, lines);
+        }
+
+#if defined(__x86_64__)
+        inline void index_lines_sse2(std::string_view content, std::vector<std::string_view>& lines)
+        {
+            index_lines_with<newline_mask_sse2>(content, lines);
+        }
+
+        // flatten so the kernel gets inlined into the avx2-enabled body instead of the generic template
+        [[gnu::target("avx2"), gnu::flatten]] inline void index_lines_avx2(
+            std::string_view               content,
+            std::vector<std::string_view>& lines
+        )
+        {
+            index_lines_with<newline_mask_avx2>(content, lines);
+        }
+#endif
+    }
+
+    // split content into lines (without the line terminator, "\n" or "\r\n"), appending them into `lines`
+    inline void index_lines(std::string_view content, std::vector<std::string_view>& lines)
+    {
+#if defined(__x86_64__)
+        static const auto has_avx2 = __builtin_cpu_supports("avx2");
+        if (has_avx2) {
+            detail::index_lines_avx2(content, lines);
+        } else {
+            detail::index_lines_sse2(content, lines);
+        }
+#else
+        detail::index_lines_scalar(content, lines);
+#endif
+    }
+}
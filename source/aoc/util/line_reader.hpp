@@ -0,0 +1,144 @@
+#pragma once
+
+#include "util/line_index.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace aoc::util
+{
+    // reads a file descriptor in fixed-size chunks and hands out its lines one by one (same semantics as
+    // index_lines); memory use is bounded by the chunk size and the longest line, not by the content size
+    class LineReader
+    {
+    public:
+        static constexpr auto default_chunk_size = 1uz << 20;
+
+        // returns std::nullopt if the file can't be opened
+        static std::optional<LineReader> open(
+            const std::filesystem::path& path,
+            std::size_t                  chunk_size = default_chunk_size
+        ) noexcept
+        {
+            auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                return std::nullopt;
+            }
+
+            // fails on pipes and the like, which is fine
+            ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+            return LineReader{ fd, true, chunk_size };
+        }
+
+        // the descriptor (e.g. STDIN_FILENO) is not closed on destruction
+        static LineReader borrow(int fd, std::size_t chunk_size = default_chunk_size) noexcept
+        {
+            return LineReader{ fd, false, chunk_size };
+        }
+
+        LineReader(LineReader&& other) noexcept
+            : m_fd{ std::exchange(other.m_fd, -1) }
+            , m_owned{ std::exchange(other.m_owned, false) }
+            , m_chunk_size{ other.m_chunk_size }
+        {
+        }
+
+        LineReader& operator=(LineReader&& other) noexcept
+        {
+            if (this != &other) {
+                close();
+                m_fd         = std::exchange(other.m_fd, -1);
+                m_owned      = std::exchange(other.m_owned, false);
+                m_chunk_size = other.m_chunk_size;
+            }
+            return *this;
+        }
+
+        LineReader(const LineReader&)            = delete;
+        LineReader& operator=(const LineReader&) = delete;
+
+        ~LineReader() { close(); }
+
+        // call `fn(line)` for every line until the end of the input, a line is only valid during the call;
+        // returns the errno of the failed read or 0
+        template <std::invocable<std::string_view> Fn>
+        int for_each_line(Fn&& fn)
+        {
+            auto buffer = std::vector<char>(m_chunk_size);
+            auto lines  = std::vector<std::string_view>{};
+            auto filled = 0uz;    // the carried over partial line is at the front
+
+            auto flush = [&](std::size_t size) {
+                lines.clear();
+                index_lines({ buffer.data(), size }, lines);
+                for (auto line : lines) {
+                    fn(line);
+                }
+            };
+
+            while (true) {
+                if (filled == buffer.size()) {
+                    buffer.resize(buffer.size() * 2);    // a line longer than the buffer
+                }
+
+                auto count = ::read(m_fd, buffer.data() + filled, buffer.size() - filled);
+                if (count < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    return errno;
+                } else if (count == 0) {
+                    break;
+                }
+
+                auto fresh = std::string_view{ buffer.data() + filled, static_cast<std::size_t>(count) };
+                filled     += fresh.size();
+
+                auto last = fresh.rfind('\n');
+                if (last == std::string_view::npos) {
+                    continue;
+                }
+
+                auto complete = static_cast<std::size_t>(fresh.data() - buffer.data()) + last + 1;
+                flush(complete);
+
+                std::memmove(buffer.data(), buffer.data() + complete, filled - complete);
+                filled -= complete;
+            }
+
+            if (filled > 0) {
+                flush(filled);    // last line without a terminator
+            }
+
+            return 0;
+        }
+
+    private:
+        LineReader(int fd, bool owned, std::size_t chunk_size) noexcept
+            : m_fd{ fd }
+            , m_owned{ owned }
+            , m_chunk_size{ chunk_size }
+        {
+        }
+
+        void close() noexcept
+        {
+            if (m_owned and m_fd >= 0) {
+                ::close(m_fd);
+            }
+        }
+
+        int         m_fd         = -1;
+        bool        m_owned      = false;
+        std::size_t m_chunk_size = default_chunk_size;
+    };
+}
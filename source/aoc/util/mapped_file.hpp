@@ -0,0 +1,95 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+namespace aoc::util
+{
+    // read-only private mapping of a whole regular file, unmapped on destruction
+    class MappedFile
+    {
+    public:
+        // returns std::nullopt if the file can't be opened or is not mappable (pipes, character devices, ...)
+        static std::optional<MappedFile> map(const std::filesystem::path& path) noexcept
+        {
+            auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                return std::nullopt;
+            }
+
+            struct stat st = {};
+            if (::fstat(fd, &st) != 0 or not S_ISREG(st.st_mode)) {
+                ::close(fd);
+                return std::nullopt;
+            }
+
+            auto size = static_cast<std::size_t>(st.st_size);
+            if (size == 0) {
+                // mmap refuses zero-length mapping, an empty file is still a valid file though
+                ::close(fd);
+                return MappedFile{ nullptr, 0 };
+            }
+
+            auto* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);    // the mapping holds its own reference to the file
+
+            if (addr == MAP_FAILED) {
+                return std::nullopt;
+            }
+
+            // the content is going to be scanned front to back right away; advices are not flags, so two calls
+            ::madvise(addr, size, MADV_SEQUENTIAL);
+            ::madvise(addr, size, MADV_WILLNEED);
+
+            return MappedFile{ static_cast<const char*>(addr), size };
+        }
+
+        MappedFile(MappedFile&& other) noexcept
+            : m_data{ std::exchange(other.m_data, nullptr) }
+            , m_size{ std::exchange(other.m_size, 0) }
+        {
+        }
+
+        MappedFile& operator=(MappedFile&& other) noexcept
+        {
+            if (this != &other) {
+                unmap();
+                m_data = std::exchange(other.m_data, nullptr);
+                m_size = std::exchange(other.m_size, 0);
+            }
+            return *this;
+        }
+
+        MappedFile(const MappedFile&)            = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        ~MappedFile() { unmap(); }
+
+        std::string_view view() const noexcept { return { m_data, m_size }; }
+        std::size_t      size() const noexcept { return m_size; }
+
+    private:
+        MappedFile(const char* data, std::size_t size) noexcept
+            : m_data{ data }
+            , m_size{ size }
+        {
+        }
+
+        void unmap() noexcept
+        {
+            if (m_data != nullptr) {
+                ::munmap(const_cast<char*>(m_data), m_size);
+            }
+        }
+
+        const char* m_data = nullptr;
+        std::size_t m_size = 0;
+    };
+}
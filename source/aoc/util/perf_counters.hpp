@@ -0,0 +1,262 @@
+#pragma once
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace aoc::util
+{
+    namespace detail
+    {
+        constexpr std::uint64_t cache_miss(std::uint64_t cache) noexcept
+        {
+            return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        }
+    }
+
+    // an event that can't be opened on this machine is left empty
+    struct PerfCounts
+    {
+        std::optional<double> m_cycles;
+        std::optional<double> m_instructions;
+        std::optional<double> m_l1d_misses;
+        std::optional<double> m_llc_misses;
+        std::optional<double> m_branch_misses;
+        std::optional<double> m_dtlb_misses;
+
+        std::optional<double> ipc() const
+        {
+            if (not m_cycles or not m_instructions or *m_cycles == 0.0) {
+                return std::nullopt;
+            }
+            return *m_instructions / *m_cycles;
+        }
+
+        PerfCounts& operator+=(const PerfCounts& other)
+        {
+            for (auto member : members) {
+                if (other.*member) {
+                    this->*member = (this->*member).value_or(0.0) + *(other.*member);
+                }
+            }
+            return *this;
+        }
+
+        PerfCounts operator/(double divisor) const
+        {
+            auto res = *this;
+            for (auto member : members) {
+                if (res.*member) {
+                    *(res.*member) /= divisor;
+                }
+            }
+            return res;
+        }
+
+        static constexpr auto members = std::array{
+            &PerfCounts::m_cycles,        &PerfCounts::m_instructions,  &PerfCounts::m_l1d_misses,
+            &PerfCounts::m_llc_misses,    &PerfCounts::m_branch_misses, &PerfCounts::m_dtlb_misses,
+        };
+    };
+
+    // a group of hardware counters of the calling thread (user space only), read around a region of code; the
+    // groups of more threads can be added to it (the workers a solve spreads its work on), their counts are
+    // summed. a counter only sees the thread it was opened on, not the threads that thread starts (no inherit,
+    // it doesn't go with a group read), so a worker must already be running to be counted
+    class PerfCounters
+    {
+    public:
+        // std::nullopt if perf_event_open is not available (no kernel support, perf_event_paranoid, seccomp
+        // in containers, ...), the reason is written into `reason` if provided. a thread of `others` whose
+        // counters can't be opened is left out
+        static std::optional<PerfCounters> open(
+            std::string*           reason = nullptr,
+            std::span<const pid_t> others = {}
+        )
+        {
+            auto counters = PerfCounters{};
+
+            auto group = open_group(0);
+            if (group.empty()) {
+                if (reason != nullptr) {
+                    *reason = std::strerror(errno);
+                }
+                return std::nullopt;
+            }
+            counters.m_groups.push_back(std::move(group));
+
+            for (auto tid : others) {
+                if (auto other = open_group(tid); not other.empty()) {
+                    counters.m_groups.push_back(std::move(other));
+                }
+            }
+
+            return counters;
+        }
+
+        PerfCounters(PerfCounters&& other) noexcept
+            : m_groups{ std::exchange(other.m_groups, {}) }
+        {
+        }
+
+        PerfCounters& operator=(PerfCounters&& other) noexcept
+        {
+            if (this != &other) {
+                close_all();
+                m_groups = std::exchange(other.m_groups, {});
+            }
+            return *this;
+        }
+
+        PerfCounters(const PerfCounters&)            = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        ~PerfCounters() { close_all(); }
+
+        void start() noexcept
+        {
+            for (const auto& group : m_groups) {
+                auto leader = group.front().first;
+                ::ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+                ::ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+            }
+        }
+
+        // std::nullopt if a group can't be read or was never scheduled onto the PMU while the region ran, the
+        // counts of the region would be understated
+        std::optional<PerfCounts> stop() noexcept
+        {
+            for (const auto& group : m_groups) {
+                ::ioctl(group.front().first, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+            }
+
+            auto counts = PerfCounts{};
+            for (const auto& group : m_groups) {
+                auto read = read_group(group);
+                if (not read) {
+                    return std::nullopt;
+                }
+                counts += *read;
+            }
+            return counts;
+        }
+
+    private:
+        using Member = std::optional<double> PerfCounts::*;
+
+        struct Event
+        {
+            std::uint32_t m_type;
+            std::uint64_t m_config;
+            Member        m_member;
+        };
+
+        // the first one is the group leader
+        static constexpr auto events = std::array<Event, 6>{ {
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, &PerfCounts::m_cycles },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, &PerfCounts::m_instructions },
+            { PERF_TYPE_HW_CACHE, detail::cache_miss(PERF_COUNT_HW_CACHE_L1D), &PerfCounts::m_l1d_misses },
+            { PERF_TYPE_HW_CACHE, detail::cache_miss(PERF_COUNT_HW_CACHE_LL), &PerfCounts::m_llc_misses },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, &PerfCounts::m_branch_misses },
+            { PERF_TYPE_HW_CACHE, detail::cache_miss(PERF_COUNT_HW_CACHE_DTLB), &PerfCounts::m_dtlb_misses },
+        } };
+
+        using Group = std::vector<std::pair<int, Member>>;
+
+        PerfCounters() = default;
+
+        // empty if the leader (cycles) can't be opened, the rest are optional; `tid` 0 is the calling thread
+        static Group open_group(pid_t tid)
+        {
+            auto group = Group{};
+
+            for (const auto& event : events) {
+                auto group_fd = group.empty() ? -1 : group.front().first;
+                auto fd       = open_event(event.m_type, event.m_config, tid, group_fd);
+
+                if (fd < 0) {
+                    if (group.empty()) {
+                        return group;
+                    }
+                    continue;
+                }
+
+                group.emplace_back(fd, event.m_member);
+            }
+
+            return group;
+        }
+
+        static std::optional<PerfCounts> read_group(const Group& group) noexcept
+        {
+            // layout of PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING
+            auto buffer = std::array<std::uint64_t, 3 + events.size()>{};
+            auto counts = PerfCounts{};
+
+            auto size = ::read(group.front().first, buffer.data(), sizeof(buffer));
+            if (size < static_cast<ssize_t>(3 * sizeof(std::uint64_t))) {
+                return std::nullopt;
+            }
+
+            auto nr      = buffer[0];
+            auto enabled = buffer[1];
+            auto running = buffer[2];
+            if (enabled == 0) {
+                return counts;    // the thread didn't run at all (an idle worker), there is nothing to count
+            } else if (running == 0) {
+                return std::nullopt;    // the group never got scheduled onto the PMU
+            }
+
+            // the group gets multiplexed if there are not enough hardware counters, extrapolate
+            auto scale = static_cast<double>(enabled) / static_cast<double>(running);
+            for (auto i = 0uz; i < nr and i < group.size(); ++i) {
+                counts.*(group[i].second) = static_cast<double>(buffer[3 + i]) * scale;
+            }
+
+            return counts;
+        }
+
+        static int open_event(std::uint32_t type, std::uint64_t config, pid_t tid, int group_fd) noexcept
+        {
+            auto attr = perf_event_attr{};
+
+            attr.size           = sizeof(attr);
+            attr.type           = type;
+            attr.config         = config;
+            attr.disabled       = group_fd == -1;    // only the leader, the rest follow it
+            attr.exclude_kernel = 1;
+            attr.exclude_hv     = 1;
+            attr.read_format    = PERF_FORMAT_GROUP                 //
+                             | PERF_FORMAT_TOTAL_TIME_ENABLED    //
+                             | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            auto fd = ::syscall(SYS_perf_event_open, &attr, tid, -1, group_fd, PERF_FLAG_FD_CLOEXEC);
+            return static_cast<int>(fd);
+        }
+
+        void close_all() noexcept
+        {
+            // members first, leader last
+            for (const auto& group : m_groups) {
+                for (auto it = group.rbegin(); it != group.rend(); ++it) {
+                    ::close(it->first);
+                }
+            }
+            m_groups.clear();
+        }
+
+        std::vector<Group> m_groups;    // the calling thread first
+    };
+}
@@ -0,0 +1,358 @@
+#pragma once
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <ucontext.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace aoc::util
+{
+    // the stacks are walked through the frame pointers, so only frames of code compiled with them are seen and
+    // only exported symbols get a name; the aoc target takes care of both when configured with
+    // -DAOC_PROFILING=ON, see the CMakeLists.txt. without it the frame pointer register holds anything, so the
+    // profiler is not available at all rather than walking garbage
+#if (defined(__x86_64__) or defined(__aarch64__)) and defined(AOC_PROFILING)
+    inline constexpr auto profiling_supported = true;
+#else
+    inline constexpr auto profiling_supported = false;
+#endif
+
+    // what the current thread is doing as far as the harness knows, a sample is attributed to it; every field
+    // points to a string with static storage duration or is null
+    struct ProfileLabel
+    {
+        const char* m_day   = nullptr;
+        const char* m_part  = nullptr;
+        const char* m_phase = nullptr;
+    };
+
+    // constinit so that reading it from the signal handler is a plain TLS access
+    inline thread_local constinit auto profile_label = ProfileLabel{};
+
+    // the label is only ever read by the signal handler, which the compiler doesn't know about: without the
+    // fences a label set around a call that doesn't look at it is optimized away as a dead store
+    inline ProfileLabel exchange_profile_label(ProfileLabel label) noexcept
+    {
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+        auto previous = std::exchange(profile_label, label);
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+        return previous;
+    }
+
+    // sets a field of the label of the current thread for its lifetime, cheap enough to be left in when nothing
+    // is being profiled
+    class ProfileScope
+    {
+    public:
+        ProfileScope(const char* ProfileLabel::* field, const char* value) noexcept
+            : m_field{ field }
+            , m_previous{ profile_label.*field }
+        {
+            auto label   = profile_label;
+            label.*field = value;
+            exchange_profile_label(label);
+        }
+
+        ProfileScope(const ProfileScope&)            = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+        ~ProfileScope()
+        {
+            auto label     = profile_label;
+            label.*m_field = m_previous;
+            exchange_profile_label(label);
+        }
+
+    private:
+        const char* ProfileLabel::* m_field;
+        const char*                 m_previous;
+    };
+
+    inline ProfileScope profile_day(const char* day) noexcept { return { &ProfileLabel::m_day, day }; }
+    inline ProfileScope profile_part(const char* part) noexcept { return { &ProfileLabel::m_part, part }; }
+    inline ProfileScope profile_phase(const char* phase) noexcept { return { &ProfileLabel::m_phase, phase }; }
+
+    // the stack of the current thread, the stack walk never reads outside of it; zero until recorded, a thread
+    // that hasn't recorded it only gets its pc sampled
+    struct StackBounds
+    {
+        std::uintptr_t m_low  = 0;
+        std::uintptr_t m_high = 0;
+    };
+
+    inline thread_local constinit auto stack_bounds = StackBounds{};
+
+    // at the start of every thread that may be sampled: the pool workers, and the thread starting the profiler
+    inline void record_stack_bounds() noexcept
+    {
+        auto attr = ::pthread_attr_t{};
+        if (::pthread_getattr_np(::pthread_self(), &attr) != 0) {
+            return;
+        }
+
+        auto* addr = static_cast<void*>(nullptr);
+        auto  size = 0uz;
+        if (::pthread_attr_getstack(&attr, &addr, &size) == 0) {
+            auto low = reinterpret_cast<std::uintptr_t>(addr);
+            stack_bounds = { .m_low = low, .m_high = low + size };
+            std::atomic_signal_fence(std::memory_order_seq_cst);    // read by the signal handler only
+        }
+        ::pthread_attr_destroy(&attr);
+    }
+
+    namespace detail
+    {
+        inline constexpr auto profile_max_depth = 64uz;
+
+        struct ProfileSample
+        {
+            ProfileLabel                                  m_label;
+            std::uint32_t                                 m_depth;
+            std::array<std::uintptr_t, profile_max_depth> m_frames;    // innermost first
+        };
+
+        // the signal handler only touches what is in here, which is set up before the timer is armed
+        struct ProfilerState
+        {
+            std::unique_ptr<ProfileSample[]> m_samples;
+            std::size_t                      m_capacity = 0;
+            std::atomic<std::size_t>         m_next     = 0;    // may go past the capacity, those are dropped
+        };
+
+        inline auto profiler_state = ProfilerState{};
+
+        inline void on_sigprof(int /* signal */, siginfo_t* /* info */, void* context) noexcept
+        {
+            auto& state = profiler_state;
+            auto  index = state.m_next.fetch_add(1, std::memory_order_relaxed);
+            if (index >= state.m_capacity) {
+                return;
+            }
+
+            const auto& mcontext = static_cast<ucontext_t*>(context)->uc_mcontext;
+#if defined(__x86_64__)
+            auto pc = static_cast<std::uintptr_t>(mcontext.gregs[REG_RIP]);
+            auto sp = static_cast<std::uintptr_t>(mcontext.gregs[REG_RSP]);
+            auto fp = static_cast<std::uintptr_t>(mcontext.gregs[REG_RBP]);
+#elif defined(__aarch64__)
+            auto pc = static_cast<std::uintptr_t>(mcontext.pc);
+            auto sp = static_cast<std::uintptr_t>(mcontext.sp);
+            auto fp = static_cast<std::uintptr_t>(mcontext.regs[29]);
+#else
+            auto pc = std::uintptr_t{ 0 }, sp = std::uintptr_t{ 0 }, fp = std::uintptr_t{ 0 };
+#endif
+
+            auto& sample       = state.m_samples[index];
+            sample.m_label     = profile_label;
+            sample.m_frames[0] = pc;
+            sample.m_depth     = 1;
+
+            // a frame is [previous fp, return address]; the walk stays between the stack pointer and the top of
+            // the stack of the thread, so a frame pointer that isn't one (a frame of code built without them, libc)
+            // ends it instead of being read through
+            const auto bounds = stack_bounds;
+            auto       inside = [&](std::uintptr_t fp) {
+                return fp >= sp and fp >= bounds.m_low and fp <= bounds.m_high - 2 * sizeof(std::uintptr_t);
+            };
+            while (sample.m_depth < profile_max_depth and bounds.m_high != 0 and inside(fp) and fp % 8 == 0) {
+                auto* frame = reinterpret_cast<const std::uintptr_t*>(fp);
+                if (frame[1] == 0) {
+                    break;
+                }
+                sample.m_frames[sample.m_depth++] = frame[1];
+                if (frame[0] <= fp) {
+                    break;    // the stack grows down, the caller's frame is always above
+                }
+                fp = frame[0];
+            }
+        }
+
+        inline std::string fmt_hex(std::uintptr_t value)
+        {
+            auto buffer = std::array<char, 2 * sizeof(value) + 1>{};
+            std::snprintf(buffer.data(), buffer.size(), "%lx", static_cast<unsigned long>(value));
+            return buffer.data();
+        }
+
+        inline std::string symbolize(std::uintptr_t address)
+        {
+            auto info = Dl_info{};
+            if (::dladdr(reinterpret_cast<void*>(address), &info) == 0 or info.dli_sname == nullptr) {
+                auto base   = reinterpret_cast<std::uintptr_t>(info.dli_fbase);
+                auto object = info.dli_fname != nullptr ? std::filesystem::path{ info.dli_fname }.filename() : "?";
+                return object.string() + "+0x" + fmt_hex(address - base);
+            }
+
+            auto status    = 0;
+            auto demangled = std::unique_ptr<char, decltype(&std::free)>{
+                abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status),
+                &std::free,
+            };
+
+            auto name = std::string{ status == 0 ? demangled.get() : info.dli_sname };
+            std::ranges::replace(name, ';', ':');    // the frame separator of the collapsed format
+            return name;
+        }
+    }
+
+    // samples the stacks of the threads of the process that are using cpu (ITIMER_PROF / SIGPROF) until it's
+    // stopped or destroyed; only one may be running at a time
+    class SamplingProfiler
+    {
+    public:
+        static constexpr auto default_frequency = 997;    // Hz, off the round numbers so it doesn't run in lockstep
+        static constexpr auto max_samples       = 1uz << 15;
+
+        // returns std::nullopt if profiling is not supported here, another profiler is running, or the timer
+        // can't be armed
+        static std::optional<SamplingProfiler> start(int frequency = default_frequency)
+        {
+            auto& state = detail::profiler_state;
+            if (not profiling_supported or state.m_samples != nullptr) {
+                return std::nullopt;
+            }
+
+            record_stack_bounds();
+
+            state.m_samples  = std::make_unique_for_overwrite<detail::ProfileSample[]>(max_samples);
+            state.m_capacity = max_samples;
+            state.m_next.store(0, std::memory_order_relaxed);
+
+            struct sigaction action = {};
+            action.sa_sigaction     = detail::on_sigprof;
+            action.sa_flags         = SA_SIGINFO | SA_RESTART;
+            ::sigemptyset(&action.sa_mask);
+
+            auto interval = ::timeval{ .tv_sec = 0, .tv_usec = 1'000'000 / frequency };
+            auto timer    = ::itimerval{ .it_interval = interval, .it_value = interval };
+
+            struct sigaction old_action = {};
+            if (::sigaction(SIGPROF, &action, &old_action) != 0) {
+                state.m_samples.reset();
+                return std::nullopt;
+            }
+            if (::setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+                ::sigaction(SIGPROF, &old_action, nullptr);
+                state.m_samples.reset();
+                return std::nullopt;
+            }
+
+            return SamplingProfiler{};
+        }
+
+        SamplingProfiler(SamplingProfiler&& other) noexcept
+            : m_running{ std::exchange(other.m_running, false) }
+            , m_owner{ std::exchange(other.m_owner, false) }
+        {
+        }
+
+        SamplingProfiler& operator=(SamplingProfiler&&) = delete;
+
+        ~SamplingProfiler()
+        {
+            stop();
+            if (m_owner) {
+                detail::profiler_state.m_samples.reset();
+            }
+        }
+
+        // the timer is disarmed but a signal may still be in flight, so SIGPROF is ignored from then on rather than
+        // given back its default action (which terminates)
+        void stop() noexcept
+        {
+            if (not std::exchange(m_running, false)) {
+                return;
+            }
+
+            auto disarm = ::itimerval{};
+            ::setitimer(ITIMER_PROF, &disarm, nullptr);
+
+            struct sigaction ignore = {};
+            ignore.sa_handler       = SIG_IGN;
+            ::sigaction(SIGPROF, &ignore, nullptr);
+        }
+
+        std::size_t sample_count() const noexcept
+        {
+            return std::min(detail::profiler_state.m_next.load(), detail::profiler_state.m_capacity);
+        }
+
+        std::size_t dropped_count() const noexcept
+        {
+            auto taken = detail::profiler_state.m_next.load();
+            return taken - sample_count();
+        }
+
+        // writes the samples taken so far in the collapsed stack format of flamegraph.pl/inferno/speedscope, one
+        // line per distinct stack: `day;part;phase;outermost;...;innermost count`; stop() first. returns false if
+        // the file can't be written
+        bool write_collapsed(const std::filesystem::path& path) const
+        {
+            const auto& state = detail::profiler_state;
+
+            auto names  = std::map<std::uintptr_t, std::string>{};
+            auto stacks = std::map<std::string, std::size_t>{};
+
+            auto name_of = [&](std::uintptr_t address) -> const std::string& {
+                auto [it, inserted] = names.try_emplace(address);
+                if (inserted) {
+                    it->second = detail::symbolize(address);
+                }
+                return it->second;
+            };
+
+            for (auto i = 0uz; i < sample_count(); ++i) {
+                const auto& [label, depth, frames] = state.m_samples[i];
+
+                auto stack = std::string{};
+                for (auto* part : { label.m_day, label.m_part, label.m_phase }) {
+                    if (part != nullptr) {
+                        stack.append(part).push_back(';');
+                    }
+                }
+
+                // a return address points past its call, one byte back lands in the call itself
+                for (auto j = depth; j-- > 0;) {
+                    stack.append(name_of(j == 0 ? frames[j] : frames[j] - 1)).push_back(';');
+                }
+                stack.pop_back();
+
+                ++stacks[std::move(stack)];
+            }
+
+            auto* file = std::fopen(path.c_str(), "w");
+            if (file == nullptr) {
+                return false;
+            }
+            for (const auto& [stack, count] : stacks) {
+                std::fprintf(file, "%s %zu\n", stack.c_str(), count);
+            }
+            return std::fclose(file) == 0;
+        }
+
+    private:
+        SamplingProfiler() noexcept
+            : m_running{ true }
+            , m_owner{ true }
+        {
+        }
+
+        bool m_running = false;
+        bool m_owner   = false;
+    };
+}
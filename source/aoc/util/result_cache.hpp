@@ -0,0 +1,189 @@
+#pragma once
+
+#include "util/mapped_file.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <rapidhash.h>
+
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+namespace aoc::util
+{
+    // a result is stored as its object representation
+    template <typename T>
+    concept Cacheable = std::is_trivially_copyable_v<T>;
+
+    // on-disk cache of solution results, content-addressed: the key of a result is derived from the hash of the
+    // input it was computed from. every entry is tagged with the id of the build that wrote it, an entry left by
+    // another build is treated as missing (and overwritten on the next store)
+    class ResultCache
+    {
+    public:
+        // creates the directory if needed, returns std::nullopt if that fails or if there is no build id
+        static std::optional<ResultCache> open(const std::filesystem::path& dir)
+        {
+            auto id = build_id();
+            if (not id) {
+                return std::nullopt;
+            }
+
+            auto ec = std::error_code{};
+            std::filesystem::create_directories(dir, ec);
+            if (ec) {
+                return std::nullopt;
+            }
+            return ResultCache{ dir, *id };
+        }
+
+        // the running binary is identified by its file; rebuilding it changes at least its modification time.
+        // std::nullopt if it can't be stat'ed, there is then no telling the entries of another build apart
+        static std::optional<std::uint64_t> build_id() noexcept
+        {
+            struct stat st = {};
+            if (::stat("/proc/self/exe", &st) != 0) {
+                return std::nullopt;
+            }
+
+            auto fields = std::array<std::uint64_t, 4>{
+                static_cast<std::uint64_t>(st.st_ino),
+                static_cast<std::uint64_t>(st.st_size),
+                static_cast<std::uint64_t>(st.st_mtim.tv_sec),
+                static_cast<std::uint64_t>(st.st_mtim.tv_nsec),
+            };
+            return rapidhash(fields.data(), sizeof(fields));
+        }
+
+        // returns std::nullopt if the file can't be read
+        static std::optional<std::uint64_t> hash_file(const std::filesystem::path& path) noexcept
+        {
+            auto mapped = MappedFile::map(path);
+            if (not mapped) {
+                return std::nullopt;
+            }
+            auto content = mapped->view();
+            return rapidhash(content.data(), content.size());
+        }
+
+        // the same input gives a different key for every (id, part) pair
+        static std::uint64_t key(std::uint64_t content_hash, std::string_view id, int part) noexcept
+        {
+            auto seed = content_hash ^ (static_cast<std::uint64_t>(part) * 0x9e3779b97f4a7c15);
+            return rapidhash_withSeed(id.data(), id.size(), seed);
+        }
+
+        // std::nullopt on a miss, an unreadable entry, or an entry of another build
+        template <Cacheable T>
+        std::optional<T> load(std::uint64_t key) const
+        {
+            auto fd = ::open(entry_path(key).c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                return std::nullopt;
+            }
+
+            auto header = Header{};
+            auto value  = std::array<unsigned char, sizeof(T)>{};
+            auto ok     = read_all(fd, &header, sizeof(header)) and read_all(fd, value.data(), value.size());
+            ::close(fd);
+
+            if (not ok or header.m_build_id != m_build_id or header.m_size != sizeof(T)) {
+                return std::nullopt;
+            }
+
+            return std::bit_cast<T>(value);
+        }
+
+        // best effort, a failure only means the next load misses. the entry is written to a temporary file then
+        // renamed over the old one, so a concurrent load sees either the old or the new entry in full
+        template <Cacheable T>
+        void store(std::uint64_t key, const T& value) const
+        {
+            auto path = entry_path(key);
+            auto temp = path;
+            temp += "." + std::to_string(::getpid()) + ".tmp";
+
+            auto fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (fd < 0) {
+                return;
+            }
+
+            auto header = Header{ .m_build_id = m_build_id, .m_size = sizeof(T) };
+            auto ok     = write_all(fd, &header, sizeof(header)) and write_all(fd, &value, sizeof(T));
+            ok          = ::close(fd) == 0 and ok;
+
+            if (not ok or ::rename(temp.c_str(), path.c_str()) != 0) {
+                ::unlink(temp.c_str());
+            }
+        }
+
+        const std::filesystem::path& dir() const noexcept { return m_dir; }
+
+    private:
+        struct Header
+        {
+            std::uint64_t m_build_id;
+            std::uint64_t m_size;
+        };
+
+        ResultCache(std::filesystem::path dir, std::uint64_t build_id) noexcept
+            : m_dir{ std::move(dir) }
+            , m_build_id{ build_id }
+        {
+        }
+
+        static bool read_all(int fd, void* data, std::size_t size) noexcept
+        {
+            auto* ptr = static_cast<char*>(data);
+            while (size > 0) {
+                auto count = ::read(fd, ptr, size);
+                if (count < 0 and errno == EINTR) {
+                    continue;
+                } else if (count <= 0) {
+                    return false;
+                }
+                ptr  += count;
+                size -= static_cast<std::size_t>(count);
+            }
+            return true;
+        }
+
+        static bool write_all(int fd, const void* data, std::size_t size) noexcept
+        {
+            auto* ptr = static_cast<const char*>(data);
+            while (size > 0) {
+                auto count = ::write(fd, ptr, size);
+                if (count < 0 and errno == EINTR) {
+                    continue;
+                } else if (count <= 0) {
+                    return false;
+                }
+                ptr  += count;
+                size -= static_cast<std::size_t>(count);
+            }
+            return true;
+        }
+
+        std::filesystem::path entry_path(std::uint64_t key) const
+        {
+            auto name = std::array<char, 17>{};
+            std::snprintf(name.data(), name.size(), "%016lx", static_cast<unsigned long>(key));
+            return m_dir / name.data();
+        }
+
+        std::filesystem::path m_dir;
+        std::uint64_t         m_build_id;
+    };
+}
@@ -0,0 +1,219 @@
+#pragma once
+
+#include "util/mapped_file.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace aoc::util
+{
+    // a value that is written to a snapshot as its object representation
+    template <typename T>
+    concept Blittable = std::is_trivially_copyable_v<T> and alignof(T) <= 8;
+
+    namespace detail
+    {
+        inline constexpr auto snapshot_magic  = std::array<char, 8>{ 'a', 'o', 'c', 's', 'n', 'a', 'p', '\0' };
+        inline constexpr auto snapshot_format = std::uint32_t{ 1 };    // of the layout below, not of the content
+
+        // followed by the payload: values back to back, a span is its length then its elements aligned to 8
+        struct SnapshotHeader
+        {
+            std::array<char, 8> m_magic;
+            std::uint32_t       m_format;
+            std::uint32_t       m_version;    // of the content, owned by whoever writes it
+            std::array<char, 8> m_id;
+            std::uint64_t       m_payload_size;
+        };
+
+        inline std::array<char, 8> snapshot_id(std::string_view id) noexcept
+        {
+            auto result = std::array<char, 8>{};
+            std::copy_n(id.begin(), std::min(id.size(), result.size()), result.begin());
+            return result;
+        }
+    }
+
+    // builds the payload of a snapshot in memory, then writes it out in one go
+    class SnapshotWriter
+    {
+    public:
+        template <Blittable T>
+        void write(const T& value)
+        {
+            append(&value, sizeof(T));
+        }
+
+        template <Blittable T>
+        void write_span(std::span<const T> values)
+        {
+            write(static_cast<std::uint64_t>(values.size()));
+            m_payload.resize((m_payload.size() + 7) / 8 * 8);
+            append(values.data(), values.size_bytes());
+        }
+
+        // the file is written next to `path` then renamed over it, returns false if any of that fails
+        bool save(const std::filesystem::path& path, std::string_view id, std::uint32_t version) const noexcept
+        {
+            auto header = detail::SnapshotHeader{
+                .m_magic        = detail::snapshot_magic,
+                .m_format       = detail::snapshot_format,
+                .m_version      = version,
+                .m_id           = detail::snapshot_id(id),
+                .m_payload_size = m_payload.size(),
+            };
+
+            auto temp = path;
+            temp += "." + std::to_string(::getpid()) + ".tmp";
+
+            auto fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (fd < 0) {
+                return false;
+            }
+
+            auto ok = write_all(fd, &header, sizeof(header)) and write_all(fd, m_payload.data(), m_payload.size());
+            ok      = ::close(fd) == 0 and ok;
+
+            if (not ok or ::rename(temp.c_str(), path.c_str()) != 0) {
+                ::unlink(temp.c_str());
+                return false;
+            }
+            return true;
+        }
+
+        std::size_t size() const noexcept { return sizeof(detail::SnapshotHeader) + m_payload.size(); }
+
+    private:
+        void append(const void* data, std::size_t size)
+        {
+            auto old_size = m_payload.size();
+            m_payload.resize(old_size + size);
+            std::memcpy(m_payload.data() + old_size, data, size);
+        }
+
+        static bool write_all(int fd, const void* data, std::size_t size) noexcept
+        {
+            auto* ptr = static_cast<const char*>(data);
+            while (size > 0) {
+                auto count = ::write(fd, ptr, size);
+                if (count < 0 and errno == EINTR) {
+                    continue;
+                } else if (count <= 0) {
+                    return false;
+                }
+                ptr  += count;
+                size -= static_cast<std::size_t>(count);
+            }
+            return true;
+        }
+
+        std::vector<std::byte> m_payload;
+    };
+
+    // a read past the end of the payload: the snapshot passed the checks of SnapshotReader::open but its content
+    // is damaged, or was written by a save_snapshot that doesn't match the load_snapshot reading it
+    struct SnapshotError : std::runtime_error
+    {
+        using std::runtime_error::runtime_error;
+    };
+
+    // reads a snapshot straight from its mapping: a span is handed out in place, nothing is decoded; a read past
+    // its end throws SnapshotError
+    class SnapshotReader
+    {
+    public:
+        // returns std::nullopt if the file can't be mapped, is not a snapshot, or was written with another `id`,
+        // `version` or layout
+        static std::optional<SnapshotReader> open(
+            const std::filesystem::path& path,
+            std::string_view             id,
+            std::uint32_t                version
+        ) noexcept
+        {
+            auto mapped = MappedFile::map(path);
+            if (not mapped or mapped->view().size() < sizeof(detail::SnapshotHeader)) {
+                return std::nullopt;
+            }
+
+            auto header = detail::SnapshotHeader{};
+            std::memcpy(&header, mapped->view().data(), sizeof(header));
+
+            auto valid = header.m_magic == detail::snapshot_magic and header.m_format == detail::snapshot_format
+                     and header.m_version == version and header.m_id == detail::snapshot_id(id)
+                     and header.m_payload_size == mapped->view().size() - sizeof(header);
+
+            if (not valid) {
+                return std::nullopt;
+            }
+
+            return SnapshotReader{ std::move(*mapped) };
+        }
+
+        template <Blittable T>
+        T read()
+        {
+            auto bytes = std::array<char, sizeof(T)>{};
+            std::memcpy(bytes.data(), take(sizeof(T)), sizeof(T));
+            return std::bit_cast<T>(bytes);
+        }
+
+        // points into the mapping, valid as long as the reader is
+        template <Blittable T>
+        std::span<const T> read_span()
+        {
+            auto size = read<std::uint64_t>();
+            m_offset  = (m_offset + 7) / 8 * 8;
+            if (size > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+                throw SnapshotError{ "read past the end of the snapshot" };
+            }
+
+            // the mapping is page aligned and the header a multiple of 8 in size, so the elements are aligned too
+            auto* data = reinterpret_cast<const T*>(take(size * sizeof(T)));
+            return { data, size };
+        }
+
+        // back to the start of the payload, to read it again
+        void rewind() noexcept { m_offset = 0; }
+
+    private:
+        static_assert(sizeof(detail::SnapshotHeader) % 8 == 0);
+
+        explicit SnapshotReader(MappedFile file) noexcept
+            : m_file{ std::move(file) }
+        {
+        }
+
+        const char* take(std::size_t size)
+        {
+            auto payload = m_file.view().substr(sizeof(detail::SnapshotHeader));
+            if (m_offset > payload.size() or size > payload.size() - m_offset) {
+                throw SnapshotError{ "read past the end of the snapshot" };
+            }
+
+            auto* data  = payload.data() + m_offset;
+            m_offset   += size;
+            return data;
+        }
+
+        MappedFile  m_file;
+        std::size_t m_offset = 0;
+    };
+}
@@ -0,0 +1,295 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace aoc::util
+{
+    // descriptive statistics of a set of samples, all of them in the unit of the samples
+    template <typename T>
+    struct Stats
+    {
+        T m_min;
+        T m_max;
+        T m_mean;
+        T m_median;
+        T m_p90;
+        T m_p99;
+        T m_stddev;
+        T m_mad;    // median absolute deviation (unscaled)
+
+        std::vector<std::size_t> m_outliers;    // indices into the samples
+    };
+
+    // the outlier rule is the modified z-score: |x - median| / (1.4826 * MAD) > 3.5 [Iglewicz & Hoaglin]
+    inline constexpr auto mad_normal_scale      = 1.4826;
+    inline constexpr auto outlier_z_score_limit = 3.5;
+
+    // the scale of the outlier rule when the MAD is 0, relative to the median (see compute_stats)
+    inline constexpr auto outlier_min_scale = 0.01;
+
+    // `sorted` must be sorted and not empty, p in [0, 1]; linear interpolation between closest ranks
+    inline double percentile_sorted(std::span<const double> sorted, double p)
+    {
+        auto rank  = p * static_cast<double>(sorted.size() - 1);
+        auto lo    = static_cast<std::size_t>(std::floor(rank));
+        auto hi    = std::min(lo + 1, sorted.size() - 1);
+        auto fract = rank - static_cast<double>(lo);
+        return sorted[lo] + (sorted[hi] - sorted[lo]) * fract;
+    }
+
+    inline double median_of(std::vector<double> values)
+    {
+        std::ranges::sort(values);
+        return percentile_sorted(values, 0.5);
+    }
+
+    // percentile bootstrap: the interval holding `confidence` of the medians of `resamples` resamplings (with
+    // replacement) of `values`, which must not be empty. deterministic, the generator is always seeded the same
+    inline std::pair<double, double> bootstrap_median_ci(
+        std::span<const double> values,
+        double                  confidence = 0.95,
+        std::size_t             resamples  = 1000
+    )
+    {
+        auto generator = std::mt19937_64{ 0x5eed };
+        auto pick      = std::uniform_int_distribution<std::size_t>{ 0, values.size() - 1 };
+
+        auto medians  = std::vector<double>(resamples);
+        auto resample = std::vector<double>(values.size());
+
+        for (auto& median : medians) {
+            std::ranges::generate(resample, [&] { return values[pick(generator)]; });
+            auto middle = resample.begin() + static_cast<std::ptrdiff_t>(resample.size() / 2);
+            std::ranges::nth_element(resample, middle);
+            median = *middle;
+        }
+
+        std::ranges::sort(medians);
+        auto tail = (1.0 - confidence) / 2.0;
+        return { percentile_sorted(medians, tail), percentile_sorted(medians, 1.0 - tail) };
+    }
+
+    // whether the samples (in the order they were taken) no longer trend down: the median of the older half is
+    // within `tolerance` of the median of the newer half. a warm-up is done when this holds for the last few
+    inline bool trend_settled(std::span<const double> samples, double tolerance = 0.02)
+    {
+        auto half  = samples.size() / 2;
+        auto older = median_of({ samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(half) });
+        auto newer = median_of({ samples.end() - static_cast<std::ptrdiff_t>(half), samples.end() });
+        return older <= newer * (1.0 + tolerance);
+    }
+
+    // one-sided mann-whitney u test: the p-value of the hypothesis that a value of `a` is as likely to be smaller
+    // than one of `b` as it is to be larger, against `a` tending to be larger. normal approximation with the tie
+    // correction and a continuity correction, good enough from ~10 samples on each side; 1 if either is empty
+    inline double mann_whitney_greater(std::span<const double> a, std::span<const double> b)
+    {
+        if (a.empty() or b.empty()) {
+            return 1.0;
+        }
+
+        auto values = std::vector<std::pair<double, bool>>{};    // (value, from a)
+        values.reserve(a.size() + b.size());
+        for (auto v : a) {
+            values.emplace_back(v, true);
+        }
+        for (auto v : b) {
+            values.emplace_back(v, false);
+        }
+        std::ranges::sort(values);
+
+        // ties get the average of the ranks they span
+        auto rank_sum_a = 0.0;
+        auto tie_term   = 0.0;
+        for (auto i = 0uz; i < values.size();) {
+            auto j = i;
+            while (j < values.size() and values[j].first == values[i].first) {
+                ++j;
+            }
+
+            auto ties = static_cast<double>(j - i);
+            auto rank = static_cast<double>(i + j + 1) / 2.0;    // 1-based, average of i + 1 .. j
+            for (auto k = i; k < j; ++k) {
+                rank_sum_a += values[k].second ? rank : 0.0;
+            }
+            tie_term += ties * ties * ties - ties;
+            i         = j;
+        }
+
+        auto n1 = static_cast<double>(a.size());
+        auto n2 = static_cast<double>(b.size());
+        auto n  = n1 + n2;
+
+        auto u        = rank_sum_a - n1 * (n1 + 1.0) / 2.0;
+        auto mean     = n1 * n2 / 2.0;
+        auto variance = n1 * n2 / 12.0 * ((n + 1.0) - tie_term / (n * (n - 1.0)));
+        if (variance <= 0.0) {
+            return 1.0;    // every value is the same
+        }
+
+        auto z = (u - mean - 0.5) / std::sqrt(variance);
+        return 0.5 * std::erfc(z / std::sqrt(2.0));
+    }
+
+    enum class Complexity
+    {
+        Constant,
+        Linear,
+        Linearithmic,
+        Quadratic,
+        Cubic,
+    };
+
+    inline std::string_view complexity_notation(Complexity complexity) noexcept
+    {
+        switch (complexity) {
+        case Complexity::Constant: return "O(1)";
+        case Complexity::Linear: return "O(n)";
+        case Complexity::Linearithmic: return "O(n log n)";
+        case Complexity::Quadratic: return "O(n^2)";
+        case Complexity::Cubic: return "O(n^3)";
+        }
+        return "O(?)";
+    }
+
+    struct ComplexityFit
+    {
+        Complexity m_complexity;
+        double     m_coefficient;    // time = coefficient * f(n), in the unit of the times
+        double     m_error;          // root mean square of the error of the model relative to the times
+    };
+
+    // fits `times` measured at `sizes` to time = c * f(n) for every model, best first. the error is taken
+    // relative to the time so that on a geometric series of sizes the small ones weigh as much as the big ones (a
+    // plain least squares fit only sees the biggest few); both must have the same length, with no time equal to 0
+    inline std::vector<ComplexityFit> fit_complexity(std::span<const double> sizes, std::span<const double> times)
+    {
+        auto model = [](Complexity complexity, double n) {
+            switch (complexity) {
+            case Complexity::Constant: return 1.0;
+            case Complexity::Linear: return n;
+            case Complexity::Linearithmic: return n * std::log2(std::max(n, 2.0));
+            case Complexity::Quadratic: return n * n;
+            case Complexity::Cubic: return n * n * n;
+            }
+            return 1.0;
+        };
+
+        auto fits = std::vector<ComplexityFit>{};
+        for (auto complexity : { Complexity::Constant,
+                                 Complexity::Linear,
+                                 Complexity::Linearithmic,
+                                 Complexity::Quadratic,
+                                 Complexity::Cubic }) {
+            // minimizes sum((t - c * f) / t)^2
+            auto num = 0.0;
+            auto den = 0.0;
+            for (auto i = 0uz; i < sizes.size(); ++i) {
+                auto ratio  = model(complexity, sizes[i]) / times[i];
+                num        += ratio;
+                den        += ratio * ratio;
+            }
+            auto coefficient = den > 0.0 ? num / den : 0.0;
+
+            auto squares = 0.0;
+            for (auto i = 0uz; i < sizes.size(); ++i) {
+                auto error  = (times[i] - coefficient * model(complexity, sizes[i])) / times[i];
+                squares    += error * error;
+            }
+            auto error = std::sqrt(squares / static_cast<double>(std::max(sizes.size(), 1uz)));
+
+            fits.push_back({ .m_complexity = complexity, .m_coefficient = coefficient, .m_error = error });
+        }
+
+        std::ranges::stable_sort(fits, {}, &ComplexityFit::m_error);
+        return fits;
+    }
+
+    // T is either an arithmetic type or a std::chrono::duration
+    template <typename T>
+    Stats<T> compute_stats(std::span<const T> samples)
+    {
+        if (samples.empty()) {
+            return {};
+        }
+
+        auto to_double = [](const T& v) {
+            if constexpr (std::is_arithmetic_v<T>) {
+                return static_cast<double>(v);
+            } else {
+                return static_cast<double>(v.count());
+            }
+        };
+
+        auto from_double = [](double v) {
+            if constexpr (std::is_arithmetic_v<T>) {
+                return static_cast<T>(v);
+            } else {
+                return T{ static_cast<typename T::rep>(std::llround(v)) };
+            }
+        };
+
+        auto values = std::vector<double>(samples.size());
+        std::ranges::transform(samples, values.begin(), to_double);
+
+        auto sorted = values;
+        std::ranges::sort(sorted);
+
+        auto size   = static_cast<double>(values.size());
+        auto mean   = std::accumulate(values.begin(), values.end(), 0.0) / size;
+        auto median = percentile_sorted(sorted, 0.5);
+
+        auto sq_sum = std::accumulate(values.begin(), values.end(), 0.0, [&](double acc, double v) {
+            return acc + (v - mean) * (v - mean);
+        });
+        auto stddev = values.size() > 1 ? std::sqrt(sq_sum / (size - 1.0)) : 0.0;
+
+        auto deviations = std::vector<double>(values.size());
+        std::ranges::transform(values, deviations.begin(), [&](double v) { return std::abs(v - median); });
+        auto mad = median_of(deviations);
+
+        // more than half of the samples equal (common with a coarse clock) make the MAD 0, which would flag
+        // nothing however far off the rest is; the scale is then a fraction of the median, one tick at least
+        constexpr auto integral = [] {
+            if constexpr (std::is_arithmetic_v<T>) {
+                return std::is_integral_v<T>;
+            } else {
+                return std::is_integral_v<typename T::rep>;
+            }
+        }();
+
+        auto scale = mad_normal_scale * mad;
+        if (scale == 0.0) {
+            scale = std::max(outlier_min_scale * std::abs(median), integral ? 1.0 : 0.0);
+        }
+
+        auto outliers = std::vector<std::size_t>{};
+        if (scale > 0.0) {
+            for (auto i = 0uz; i < values.size(); ++i) {
+                if (deviations[i] / scale > outlier_z_score_limit) {
+                    outliers.push_back(i);
+                }
+            }
+        }
+
+        return {
+            .m_min      = from_double(sorted.front()),
+            .m_max      = from_double(sorted.back()),
+            .m_mean     = from_double(mean),
+            .m_median   = from_double(median),
+            .m_p90      = from_double(percentile_sorted(sorted, 0.90)),
+            .m_p99      = from_double(percentile_sorted(sorted, 0.99)),
+            .m_stddev   = from_double(stddev),
+            .m_mad      = from_double(mad),
+            .m_outliers = std::move(outliers),
+        };
+    }
+}
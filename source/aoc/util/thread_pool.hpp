@@ -0,0 +1,179 @@
+#pragma once
+
+#include "util/profiler.hpp"
+
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace aoc::util
+{
+    // fixed number of workers pulling from a single FIFO queue, tasks are run in submission order
+    class ThreadPool
+    {
+    public:
+        explicit ThreadPool(std::size_t count)
+            : m_thread_ids(count)
+        {
+            // the workers started so far still count down `started` if spawning one of them throws
+            auto started = std::latch{ static_cast<std::ptrdiff_t>(count) };
+
+            m_workers.reserve(count);
+            for (auto i = 0uz; i < count; ++i) {
+                try {
+                    m_workers.emplace_back([this, i, &started](std::stop_token st) {
+                        m_thread_ids[i] = ::gettid();
+                        started.count_down();
+                        work(st);
+                    });
+                } catch (...) {
+                    started.count_down(static_cast<std::ptrdiff_t>(count - i));
+                    started.wait();
+                    throw;
+                }
+            }
+
+            started.wait();
+        }
+
+        ThreadPool(ThreadPool&&)            = delete;
+        ThreadPool& operator=(ThreadPool&&) = delete;
+
+        // std::jthread requests stop and joins, the queued tasks are still run before the workers exit
+        ~ThreadPool() = default;
+
+        std::size_t size() const noexcept { return m_workers.size(); }
+
+        // the kernel ids of the workers, see PerfCounters::open
+        std::span<const pid_t> thread_ids() const noexcept { return m_thread_ids; }
+
+        // an exception thrown by `fn` is rethrown by the returned future
+        template <std::invocable Fn>
+        std::future<std::invoke_result_t<Fn>> submit(Fn&& fn)
+        {
+            auto task   = std::packaged_task<std::invoke_result_t<Fn>()>{ std::forward<Fn>(fn) };
+            auto future = task.get_future();
+
+            {
+                auto lock = std::unique_lock{ m_mutex };
+                m_queue.emplace_back(std::move(task));
+            }
+            m_cv.notify_one();
+
+            return future;
+        }
+
+    private:
+        void work(std::stop_token st)
+        {
+            record_stack_bounds();
+
+            while (true) {
+                auto task = std::move_only_function<void()>{};
+
+                {
+                    auto lock = std::unique_lock{ m_mutex };
+                    if (not m_cv.wait(lock, st, [&] { return not m_queue.empty(); })) {
+                        return;    // stop requested and nothing left to do
+                    }
+                    task = std::move(m_queue.front());
+                    m_queue.pop_front();
+                }
+
+                task();
+            }
+        }
+
+        std::mutex                                  m_mutex;
+        std::condition_variable_any                 m_cv;
+        std::deque<std::move_only_function<void()>> m_queue;
+        std::vector<pid_t>                          m_thread_ids;
+        std::vector<std::jthread>                   m_workers;    // last, so it's joined before the rest is gone
+    };
+
+    // split [0, count) into chunks and call `fn(begin, end)` for each of them on the pool and on the calling
+    // thread, returns once every chunk is done; the first exception thrown by `fn` is rethrown here.
+    // the caller takes chunks too and never waits on a queued task, so it's fine to call this from a task that
+    // is itself running on the same pool (or when every worker is busy): at worst it runs everything itself
+    template <std::invocable<std::size_t, std::size_t> Fn>
+    void parallel_for(ThreadPool* pool, std::size_t count, Fn&& fn)
+    {
+        auto threads = pool != nullptr ? pool->size() + 1 : 1uz;
+        if (threads == 1 or count <= 1) {
+            if (count > 0) {
+                fn(0uz, count);
+            }
+            return;
+        }
+
+        struct Shared
+        {
+            std::size_t              m_count;
+            std::size_t              m_chunk_size;
+            std::size_t              m_chunks;
+            std::atomic<std::size_t> m_next = 0;
+            std::atomic<std::size_t> m_done = 0;
+            std::mutex               m_mutex;
+            std::exception_ptr       m_error;
+        };
+
+        // a few chunks per thread so an uneven chunk doesn't leave the others idle
+        auto chunk_size = std::max(1uz, count / (threads * 4));
+        auto shared     = std::make_shared<Shared>(count, chunk_size, (count + chunk_size - 1) / chunk_size);
+        auto fn_ptr     = &fn;
+        auto label      = profile_label;
+
+        // a helper that only starts after every chunk is taken returns without touching `fn`, which may be gone
+        // by then; `shared` is kept alive by the helpers themselves. the helpers are profiled as the caller
+        auto work = [shared, fn_ptr, label] {
+            auto previous = exchange_profile_label(label);
+            for (auto i = shared->m_next++; i < shared->m_chunks; i = shared->m_next++) {
+                auto begin = i * shared->m_chunk_size;
+                auto end   = std::min(begin + shared->m_chunk_size, shared->m_count);
+
+                try {
+                    (*fn_ptr)(begin, end);
+                } catch (...) {
+                    auto lock = std::unique_lock{ shared->m_mutex };
+                    if (not shared->m_error) {
+                        shared->m_error = std::current_exception();
+                    }
+                }
+
+                if (shared->m_done.fetch_add(1) + 1 == shared->m_chunks) {
+                    shared->m_done.notify_all();
+                }
+            }
+            exchange_profile_label(previous);
+        };
+
+        for (auto i = 1uz; i < std::min(threads, shared->m_chunks); ++i) {
+            std::ignore = pool->submit(work);
+        }
+        work();
+
+        for (auto done = shared->m_done.load(); done < shared->m_chunks; done = shared->m_done.load()) {
+            shared->m_done.wait(done);
+        }
+
+        if (shared->m_error) {
+            std::rethrow_exception(shared->m_error);
+        }
+    }
+}
@@ -0,0 +1,192 @@
+#pragma once
+
+#include "util/tsc.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+// AOC_TRACE_SCOPE("name") records the span of the enclosing scope as a zone of the current thread, the name must
+// be a string with static storage duration (a literal, or a static constexpr member like Day::name). zones are
+// only compiled in when the aoc target is configured with -DAOC_TRACING=ON, and only recorded after
+// start_tracing(); compiled out, the macro expands to nothing
+#if defined(AOC_TRACING)
+#    define AOC_TRACE_CONCAT_IMPL(a, b) a##b
+#    define AOC_TRACE_CONCAT(a, b)      AOC_TRACE_CONCAT_IMPL(a, b)
+#    define AOC_TRACE_SCOPE(name)                                                                                \
+        const auto AOC_TRACE_CONCAT(aoc_trace_scope_, __LINE__) = ::aoc::util::TraceScope{ name }
+#else
+#    define AOC_TRACE_SCOPE(name) static_cast<void>(0)
+#endif
+
+namespace aoc::util
+{
+#if defined(AOC_TRACING)
+    inline constexpr auto tracing = true;
+#else
+    inline constexpr auto tracing = false;
+#endif
+
+    namespace detail
+    {
+        struct TraceEvent
+        {
+            const char*   m_name;
+            std::uint64_t m_begin;    // ns of the steady clock, or ticks of the tsc
+            std::uint64_t m_end;
+        };
+
+        // written by its thread only; once full the oldest zones are overwritten
+        struct TraceBuffer
+        {
+            static constexpr auto capacity = 1uz << 16;
+
+            std::vector<TraceEvent>    m_events = std::vector<TraceEvent>(capacity);
+            std::atomic<std::uint64_t> m_written = 0;
+            std::uint32_t              m_tid;
+        };
+
+        struct TraceRegistry
+        {
+            std::atomic<bool>                         m_enabled = false;
+            std::atomic<bool>                         m_tsc     = false;
+            std::mutex                                m_mutex;
+            std::vector<std::shared_ptr<TraceBuffer>> m_buffers;    // outlive their threads
+        };
+
+        inline constinit auto trace_registry = TraceRegistry{};
+
+        inline std::uint64_t trace_now() noexcept
+        {
+            if (trace_registry.m_tsc.load(std::memory_order_relaxed)) {
+                return read_tsc();
+            }
+            auto now = std::chrono::steady_clock::now().time_since_epoch();
+            return static_cast<std::uint64_t>(std::chrono::nanoseconds{ now }.count());
+        }
+
+        inline TraceBuffer& thread_trace_buffer()
+        {
+            thread_local auto buffer = [] {
+                auto& registry = trace_registry;
+                auto  lock     = std::unique_lock{ registry.m_mutex };
+                auto  created  = std::make_shared<TraceBuffer>();
+                created->m_tid = static_cast<std::uint32_t>(registry.m_buffers.size());
+                registry.m_buffers.push_back(created);
+                return created;
+            }();
+            return *buffer;
+        }
+    }
+
+    // with the tsc (if it is usable) a zone costs a few ns less at either end, and short ones are timed precisely
+    inline void start_tracing(ClockSource clock = ClockSource::Chrono) noexcept
+    {
+        auto tsc = clock == ClockSource::Tsc and tsc_usable();
+        detail::trace_registry.m_tsc.store(tsc, std::memory_order_relaxed);
+        detail::trace_registry.m_enabled.store(true, std::memory_order_relaxed);
+    }
+
+    class TraceScope
+    {
+    public:
+        explicit TraceScope(const char* name) noexcept
+            : m_name{ detail::trace_registry.m_enabled.load(std::memory_order_relaxed) ? name : nullptr }
+            , m_begin{ m_name != nullptr ? detail::trace_now() : 0 }
+        {
+        }
+
+        TraceScope(const TraceScope&)            = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+
+        ~TraceScope()
+        {
+            if (m_name == nullptr) {
+                return;
+            }
+
+            auto  end    = detail::trace_now();
+            auto& buffer = detail::thread_trace_buffer();
+            auto  index  = buffer.m_written.load(std::memory_order_relaxed);
+
+            buffer.m_events[index % detail::TraceBuffer::capacity] = { m_name, m_begin, end };
+            buffer.m_written.store(index + 1, std::memory_order_release);
+        }
+
+    private:
+        const char*   m_name;
+        std::uint64_t m_begin;
+    };
+
+    // writes every zone recorded so far in the Chrome trace event format (loads in Perfetto and chrome://tracing);
+    // not to be called while zones are still being recorded. returns false if the file can't be written
+    inline bool write_chrome_trace(const std::filesystem::path& path)
+    {
+        auto* file = std::fopen(path.c_str(), "w");
+        if (file == nullptr) {
+            return false;
+        }
+
+        auto& registry = detail::trace_registry;
+        auto  lock     = std::unique_lock{ registry.m_mutex };
+
+        // the earliest zone is at 0
+        auto origin = UINT64_MAX;
+        for (const auto& buffer : registry.m_buffers) {
+            auto written = buffer->m_written.load(std::memory_order_acquire);
+            auto first   = written > detail::TraceBuffer::capacity ? written - detail::TraceBuffer::capacity : 0;
+            for (auto i = first; i < written; ++i) {
+                origin = std::min(origin, buffer->m_events[i % detail::TraceBuffer::capacity].m_begin);
+            }
+        }
+
+        auto write_name = [&](std::string_view name) {
+            for (auto c : name) {
+                if (c == '"' or c == '\\') {
+                    std::fputc('\\', file);
+                }
+                std::fputc(c, file);
+            }
+        };
+
+        auto to_us = [&](std::uint64_t time) {
+            if (registry.m_tsc.load(std::memory_order_relaxed)) {
+                return static_cast<double>(tsc_to_ns(time).count()) / 1e3;
+            }
+            return static_cast<double>(time) / 1e3;
+        };
+
+        auto separator = "";
+        std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", file);
+
+        for (const auto& buffer : registry.m_buffers) {
+            auto written = buffer->m_written.load(std::memory_order_acquire);
+            auto first   = written > detail::TraceBuffer::capacity ? written - detail::TraceBuffer::capacity : 0;
+
+            for (auto i = first; i < written; ++i) {
+                const auto& [name, begin, end] = buffer->m_events[i % detail::TraceBuffer::capacity];
+
+                std::fprintf(file, "%s\n{\"name\":\"", separator);
+                write_name(name);
+                std::fprintf(
+                    file,
+                    "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                    buffer->m_tid,
+                    to_us(begin - origin),
+                    to_us(end - begin)
+                );
+                separator = ",";
+            }
+        }
+
+        std::fputs("\n]}\n", file);
+        return std::fclose(file) == 0;
+    }
+}
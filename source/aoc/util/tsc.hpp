@@ -0,0 +1,107 @@
+#pragma once
+
+#if defined(__x86_64__)
+#    include <cpuid.h>
+#    include <x86intrin.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+namespace aoc::util
+{
+    // what the harness reads the time from: the clock through the vdso (~20ns a read), or the time stamp counter
+    // of the cpu (a few ns, sub-ns resolution); the latter only where it is invariant, see tsc_usable()
+    enum class ClockSource
+    {
+        Chrono,
+        Tsc,
+    };
+
+    // the counter as of the moment every instruction before it has completed, and before any after it has
+    // started: rdtscp waits for the preceding instructions, the lfence after it holds back the following ones
+    inline std::uint64_t read_tsc() noexcept
+    {
+#if defined(__x86_64__)
+        auto aux = 0u;
+        _mm_lfence();
+        auto ticks = __rdtscp(&aux);
+        _mm_lfence();
+        return ticks;
+#else
+        return 0;
+#endif
+    }
+
+    struct TscCalibration
+    {
+        bool          m_usable;           // invariant tsc on x86-64: constant rate, ticks through sleep states
+        double        m_ns_per_tick;      // against steady_clock
+        std::uint64_t m_read_overhead;    // ticks between two back to back reads, at best
+    };
+
+    namespace detail
+    {
+        inline bool tsc_invariant() noexcept
+        {
+#if defined(__x86_64__)
+            auto eax = 0u, ebx = 0u, ecx = 0u, edx = 0u;
+            if (__get_cpuid(0x8000'0000, &eax, &ebx, &ecx, &edx) == 0 or eax < 0x8000'0007) {
+                return false;
+            }
+            __get_cpuid(0x8000'0007, &eax, &ebx, &ecx, &edx);
+            return (edx & (1u << 8)) != 0;
+#else
+            return false;
+#endif
+        }
+
+        inline TscCalibration calibrate_tsc() noexcept
+        {
+            if (not tsc_invariant()) {
+                return { .m_usable = false, .m_ns_per_tick = 0.0, .m_read_overhead = 0 };
+            }
+
+            using Clock = std::chrono::steady_clock;
+
+            // spinning rather than sleeping, a few ns of error at either end over 20ms is well below 1ppm
+            auto clock_begin = Clock::now();
+            auto tsc_begin   = read_tsc();
+            auto clock_end   = clock_begin;
+            while (clock_end - clock_begin < std::chrono::milliseconds{ 20 }) {
+                clock_end = Clock::now();
+            }
+            auto tsc_end = read_tsc();
+
+            auto ns = std::chrono::duration<double, std::nano>{ clock_end - clock_begin }.count();
+
+            auto overhead = UINT64_MAX;
+            for (auto i = 0; i < 1000; ++i) {
+                auto first = read_tsc();
+                overhead   = std::min(overhead, read_tsc() - first);
+            }
+
+            return {
+                .m_usable        = tsc_end > tsc_begin,
+                .m_ns_per_tick   = ns / static_cast<double>(tsc_end - tsc_begin),
+                .m_read_overhead = overhead,
+            };
+        }
+    }
+
+    // calibrated on the first call, which takes ~20ms
+    inline const TscCalibration& tsc_calibration() noexcept
+    {
+        static const auto calibration = detail::calibrate_tsc();
+        return calibration;
+    }
+
+    inline bool tsc_usable() noexcept { return tsc_calibration().m_usable; }
+
+    inline std::chrono::nanoseconds tsc_to_ns(std::uint64_t ticks) noexcept
+    {
+        auto ns = static_cast<double>(ticks) * tsc_calibration().m_ns_per_tick;
+        return std::chrono::nanoseconds{ static_cast<std::int64_t>(ns + 0.5) };
+    }
+}
@@ -0,0 +1,82 @@
+#include "gen/all.hpp"
+#include "meta.hpp"
+
+#include <CLI/CLI.hpp>
+#include <fmt/base.h>
+#include <fmt/std.h>
+
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <optional>
+
+int main(int argc, char** argv)
+{
+    using aoc::gen::Generator, aoc::gen::Generators;
+
+    auto app = CLI::App{ "AOC input generator" };
+
+    auto selected_day = std::string{};
+    auto size         = std::optional<aoc::aliases::usize>{};
+    auto seed         = 0ull;
+    auto output       = std::filesystem::path{};
+    auto list         = false;
+
+    auto ids = std::vector<std::string_view>{};
+    aoc::meta::for_each_tuple<Generators>([&]<Generator G>() { ids.push_back(G::id); });
+
+    app.add_option("day", selected_day, "which day to generate an input for")->transform(CLI::IsMember{ ids });
+    app.add_option("-n,--size", size, "size of the input, see --list for what it counts");
+    app.add_option("-s,--seed", seed, "seed of the random number generator");
+    app.add_option("-o,--output", output, "write into this file instead of stdout");
+    app.add_flag("-l,--list", list, "list the generators with what their size counts");
+
+    if (argc <= 1) {
+        fmt::print("{}", app.help());
+        return 0;
+    }
+
+    CLI11_PARSE(app, argc, argv);
+
+    if (list) {
+        aoc::meta::for_each_tuple<Generators>([&]<Generator G>() {
+            fmt::println("{}: {} (default {})", G::id, G::size_unit, G::default_size);
+        });
+        return 0;
+    }
+
+    if (selected_day.empty()) {
+        fmt::println("a day is required");
+        return 1;
+    }
+
+    auto rng     = aoc::gen::Rng{ seed };
+    auto content = std::string{};
+
+    try {
+        aoc::meta::for_each_tuple<Generators>([&]<Generator G>() {
+            if (G::id == selected_day) {
+                G{}.generate(content, rng, size.value_or(G::default_size));
+            }
+        });
+    } catch (std::exception& e) {
+        fmt::println(stderr, "{}", e.what());
+        return 1;
+    }
+
+    auto* file = output.empty() ? stdout : std::fopen(output.c_str(), "wb");
+    if (file == nullptr) {
+        fmt::println(stderr, "failed to open '{}' for writing", output);
+        return 1;
+    }
+
+    auto written = std::fwrite(content.data(), 1, content.size(), file);
+    auto closed  = file == stdout ? std::fflush(file) : std::fclose(file);
+
+    if (written != content.size() or closed != 0) {
+        fmt::println(stderr, "failed to write the input");
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include "common.hpp"
+#include "day/15.hpp"
+#include "day/16.hpp"
+#include "gen/15.hpp"
+#include "gen/16.hpp"
+
+#include <fmt/base.h>
+#include <fmt/std.h>
+
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+// a stale snapshot of the input of D (its map made one column wider than the tiles it holds by `widen`) must not
+// be read: the session falls back to parsing the text and gets the same results as without a snapshot
+template <aoc::common::Day D, aoc::gen::Generator G, std::invocable<typename D::Input&> Widen>
+bool falls_back_on_stale_snapshot(const fs::path& dir, Widen widen)
+{
+    auto infile = dir / fmt::format("{}.txt", D::id);
+    auto day    = D{};
+
+    auto content = std::string{};
+    auto rng     = aoc::gen::Rng{ 0 };
+    G{}.generate(content, rng, G::default_size);
+    std::ofstream{ infile, std::ios::binary } << content;
+
+    auto expected = aoc::common::run_session(day, infile);
+
+    auto arena     = aoc::util::Arena{};
+    auto context   = aoc::common::make_context(false, {}, arena);
+    auto raw_input = aoc::common::parse_file(infile);
+    auto input     = day.parse(raw_input.m_lines, context);
+    auto writer    = aoc::util::SnapshotWriter{};
+
+    widen(input);
+    day.save_snapshot(input, writer);
+    if (not writer.save(aoc::common::snapshot_path(infile), D::id, D::snapshot_version)) {
+        fmt::println("[{}] FAILED: the snapshot can't be written", D::id);
+        return false;
+    }
+
+    auto result  = aoc::common::run_session(day, infile);
+    auto same    = [](const auto& lhs, const auto& rhs) {
+        return lhs.has_value() and rhs.has_value() and lhs->m_result == rhs->m_result;
+    };
+    auto matches = same(result.m_part_one, expected.m_part_one) and same(result.m_part_two, expected.m_part_two);
+
+    if (result.m_snapshot) {
+        fmt::println("[{}] FAILED: the stale snapshot was read", D::id);
+        return false;
+    } else if (not matches) {
+        fmt::println("[{}] FAILED: the results differ from the ones parsed from the text", D::id);
+        return false;
+    }
+
+    fmt::println("[{}] ok", D::id);
+    return true;
+}
+
+int main()
+{
+    auto dir = fs::temp_directory_path() / "aoc-test-snapshot";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    auto day15 = falls_back_on_stale_snapshot<aoc::day::Day15, aoc::gen::Gen15>(dir, [](auto& input) {
+        ++input.m_warehouse.m_width;
+    });
+    auto day16 = falls_back_on_stale_snapshot<aoc::day::Day16, aoc::gen::Gen16>(dir, [](auto& input) {
+        ++input.m_map.m_width;
+    });
+
+    fs::remove_all(dir);
+    return day15 and day16 ? 0 : 1;
+}